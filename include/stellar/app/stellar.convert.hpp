@@ -0,0 +1,18 @@
+
+#pragma once
+
+#include <seqan/arg_parse.h>
+
+namespace stellar
+{
+
+namespace app
+{
+
+///////////////////////////////////////////////////////////////////////////////
+// Program entry point of `stellar convert`: converts a binary match file (smb) into a gff file.
+int convertMain(int argc, char const * argv[]);
+
+} // namespace stellar::app
+
+} // namespace stellar
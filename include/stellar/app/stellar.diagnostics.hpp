@@ -13,6 +13,10 @@ namespace app
 // Calculates parameters from parameters in options object and writes them to std::cout
 void _writeCalculatedParams(StellarOptions & options);
 
+///////////////////////////////////////////////////////////////////////////////
+// Writes the parameters that depend on the auto-tuned k-mer length to std::cout
+void _writeAutoTunedParams(StellarOptions const & options);
+
 ///////////////////////////////////////////////////////////////////////////////
 // Writes user specified parameters from options object to std::cout
 void _writeSpecifiedParams(StellarOptions const & options);
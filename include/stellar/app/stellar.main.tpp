@@ -23,6 +23,8 @@
 
 #pragma once
 
+#include <algorithm>
+#include <memory>
 #include <variant>
 
 #include <stellar/app/stellar.main.hpp>
@@ -32,6 +34,8 @@
 #include <seqan3/core/debug_stream.hpp>
 
 #include <stellar/stellar.hpp>
+#include <stellar/stellar_binary_output.hpp>
+#include <stellar/stellar_hit_profile.hpp>
 #include <stellar/stellar_index.hpp>
 #include <stellar/stellar_output.hpp>
 #include <stellar/stellar_database_segment.hpp>
@@ -78,6 +82,22 @@ bool _shouldWriteOutputFile(bool const databaseStrand, StringSet<QueryMatches<St
     return databaseStrand || IsSameType<TAlphabet, Dna5>::VALUE || IsSameType<TAlphabet, Rna5>::VALUE;
 }
 
+///////////////////////////////////////////////////////////////////////////////
+// Writes the matches of all queries on the given database strand in the output format.
+template <typename TAlphabet, typename TId>
+void _writeMatchesToOutputFile(StringSet<QueryMatches<StellarMatch<String<TAlphabet> const, TId> > > const & matches,
+                               StringSet<TId> const & databaseIDs,
+                               StringSet<TId> const & queryIDs,
+                               bool const databaseStrand,
+                               CharString const & outputFormat,
+                               std::ostream & outputFile)
+{
+    if (outputFormat == "smb")
+        _writeAllQueryMatchesToBinaryFile(matches, databaseStrand, outputFile);
+    else
+        _writeAllQueryMatchesToFile(matches, databaseIDs, queryIDs, databaseStrand, outputFormat, outputFile);
+}
+
 template <typename TAlphabet, typename TId>
 void _postproccessQueryMatches(bool const databaseStrand, uint64_t const & refLen,
                                StellarOptions const & options,
@@ -105,6 +125,56 @@ void _postproccessQueryMatches(bool const databaseStrand, uint64_t const & refLe
         _postproccessLengthAdjustment(refLen, matches);
 }
 
+///////////////////////////////////////////////////////////////////////////////
+// Streaming output: post-processes and writes the matches of a finished database record and clears them for the
+// next record, such that numMatches and disableThresh apply per query and database. Disabled queries stay disabled
+// and are appended to disabledQueryIDs once per strand, i.e. if not already in disabledQueryIDs[strandBegin..].
+template <typename TAlphabet, typename TId>
+void _streamQueryMatches(bool const databaseStrand, uint64_t const & refLen,
+                         StellarOptions const & options,
+                         StringSet<QueryMatches<StellarMatch<String<TAlphabet> const, TId> > > & matches,
+                         StringSet<TId> const & databaseIDs,
+                         StringSet<TId> const & queryIDs,
+                         size_t const strandBegin,
+                         std::vector<size_t> & disabledQueryIDs,
+                         std::ostream & outputFile,
+                         StellarOutputStatistics & outputStatistics,
+                         stellar_strand_time & strand_time)
+{
+    using TQueryMatches = QueryMatches<StellarMatch<String<TAlphabet> const, TId> >;
+
+    std::vector<size_t> recordDisabledQueryIDs{};
+    strand_time.post_process_eps_matches_time.measure_time([&]()
+    {
+        _postproccessQueryMatches(databaseStrand, refLen, options, matches, recordDisabledQueryIDs);
+    }); // measure_time
+
+    if (_shouldWriteOutputFile(databaseStrand, matches))
+    {
+        strand_time.output_eps_matches_time.measure_time([&]()
+        {
+            _writeMatchesToOutputFile(matches, databaseIDs, queryIDs, databaseStrand, options.outputFormat, outputFile);
+            outputFile.flush();
+        }); // measure_time
+    }
+
+    StellarOutputStatistics recordStatistics = _computeOutputStatistics(matches);
+    recordStatistics.numDisabled = 0;
+    for (size_t const queryID : recordDisabledQueryIDs)
+    {
+        if (std::find(disabledQueryIDs.begin() + strandBegin, disabledQueryIDs.end(), queryID) != disabledQueryIDs.end())
+            continue;
+
+        disabledQueryIDs.push_back(queryID);
+        ++recordStatistics.numDisabled;
+    }
+    outputStatistics.mergeIn(recordStatistics);
+
+    for (TQueryMatches & queryMatches : matches)
+        if (!queryMatches.disabled)
+            queryMatches = TQueryMatches{};
+}
+
 template <typename TAlphabet, typename TId = CharString>
 struct StellarApp
 {
@@ -128,57 +198,77 @@ struct StellarApp
     static StellarComputeStatistics
     search_and_verify(
         StellarDatabaseSegment<TAlphabet> const databaseSegment,
-        TId const & databaseID,
+        size_t const databaseRecordID,
         QueryIDMap<TAlphabet> const & queryIDMap,
         bool const databaseStrand,
-        StellarOptions & localOptions, // localOptions.compactThresh is out-param
+        StellarOptions const & localOptions,
         StellarSwiftPattern<TAlphabet> & localSwiftPattern,
         stellar::stellar_kernel_runtime & strand_runtime,
-        StringSet<QueryMatches<StellarMatch<String<TAlphabet> const, TId> > > & localMatches
+        StringSet<QueryMatches<StellarMatch<String<TAlphabet> const, TId> > > & localMatches,
+        StellarHitProfile<TAlphabet, TId> * hitProfile = nullptr
     )
     {
         using TSequence = String<TAlphabet>;
 
-        auto getQueryMatches = [&](auto const & pattern) -> QueryMatches<StellarMatch<TSequence const, TId> > &
+        auto getQueryMatches = [&](TSequence const & query) -> QueryMatches<StellarMatch<TSequence const, TId> > &
         {
             // Note: Index is normally build over all queries [query0, query1, query2, ...],
             // but in LocalQueryPrefilter case it can just be build over [query0].
             // We need to translate that position to a "record" ID
             //!TODO: this shouldn't be necessary
             // each Stellar instance should be given a set of bin query, all of which should be indexed
-            size_t const queryRecordID = queryIDMap.recordID(pattern);
+            size_t const queryRecordID = queryIDMap.recordID(query);
             return value(localMatches, queryRecordID);
         };
 
-        auto isPatternDisabled = [&](StellarSwiftPattern<TAlphabet> & pattern) -> bool {
-            QueryMatches<StellarMatch<TSequence const, TId> > & queryMatches = getQueryMatches(pattern);
+        auto isQueryDisabled = [&](StellarQuerySegment<TAlphabet> const & querySegment) -> bool {
+            QueryMatches<StellarMatch<TSequence const, TId> > & queryMatches = getQueryMatches(querySegment.underlyingQuery());
             return queryMatches.disabled;
         };
 
         auto onAlignmentResult = [&](auto & alignment) -> bool {
-            QueryMatches<StellarMatch<TSequence const, TId> > & queryMatches = getQueryMatches(localSwiftPattern);
-
-            StellarMatch<TSequence const, TId> match(alignment, databaseID, databaseStrand);
-            length(match);  // DEBUG: Contains assertion on clipping.
+            // swift hits can be verified after the swift pattern moved on, so use the query of the alignment
+            QueryMatches<StellarMatch<TSequence const, TId> > & queryMatches = getQueryMatches(source(row(alignment, 1)));
 
             // success
             return _insertMatch(
                 queryMatches,
-                match,
+                alignment,
+                databaseRecordID,
+                databaseStrand,
                 localOptions.minLength,
                 localOptions.disableThresh,
-                // compactThresh is basically an output-parameter; will be updated in kernel and propagated back
-                // outside of this function, the reason why StellarOptions can't be passed as const to this function.
-                // TODO: We might want to make this tied to the QueryMatches itself, as it should know then to consolidate
-                // the matches
                 localOptions.compactThresh,
                 localOptions.numMatches
             );
         };
 
+        auto onSwiftHit = [&](StellarDatabaseSegment<TAlphabet> const & databaseSegment,
+                              StellarQuerySegment<TAlphabet> const & querySegment,
+                              bool const verified,
+                              stellar_runtime::duration_t const verificationTime)
+        {
+            if (hitProfile != nullptr)
+                hitProfile->addSwiftHit(databaseSegment, querySegment, databaseStrand, verified, verificationTime);
+        };
+
         // finder
         StellarSwiftFinder<TAlphabet> swiftFinder(databaseSegment.asInfixSegment(), localOptions.minRepeatLength, localOptions.maxRepeatPeriod);
 
+        std::vector<StellarFinderRange<TAlphabet>> finderRanges{};
+        if (localOptions.finderCount > 1u)
+        {
+            size_t maxQueryLength = 0;
+            for (auto const & query : StellarIndex<TAlphabet>::sequencesFromPattern(localSwiftPattern))
+                maxQueryLength = std::max<size_t>(maxQueryLength, length(query));
+
+            StellarStatistics const swiftStatistics{localOptions};
+            finderRanges = _partitionDatabaseSegment(databaseSegment,
+                                                     localOptions.finderCount,
+                                                     _finderRangeMargin(localOptions, maxQueryLength),
+                                                     swiftStatistics.delta);
+        }
+
         StellarComputeStatistics statistics = _verificationMethodVisit(
             localOptions.verificationMethod,
             [&](auto tag) -> StellarComputeStatistics
@@ -190,13 +280,125 @@ struct StellarApp
                     STELLAR_DESIGNATED_INITIALIZER(.verifier_options = , localOptions),
                 };
 
-                return _stellarKernel(swiftFinder, localSwiftPattern, swiftVerifier, isPatternDisabled, onAlignmentResult, strand_runtime);
+                if (finderRanges.size() > 1u)
+                    return _stellarKernel(finderRanges, localOptions.minRepeatLength, localOptions.maxRepeatPeriod,
+                                          localSwiftPattern, swiftVerifier, isQueryDisabled, onAlignmentResult,
+                                          onSwiftHit, strand_runtime);
+
+                return _stellarKernel(swiftFinder, localSwiftPattern, swiftVerifier, isQueryDisabled, onAlignmentResult,
+                                     onSwiftHit, strand_runtime);
             });
 
         return statistics;
     }
 };
 
+///////////////////////////////////////////////////////////////////////////////
+// Returns the q-gram lengths that are tried by the auto-tuning. These are the q-gram lengths around the computed
+// default (options.qGram) for which the SWIFT filter stays lossless.
+inline std::vector<unsigned> _autoTuneQGramCandidates(StellarOptions const & options)
+{
+    std::vector<unsigned> candidates{};
+
+    unsigned const minQGram = std::max(options.qGram, 4u) - 3u;
+    unsigned const maxQGram = std::min(options.qGram + 1u, 32u);
+    for (unsigned qGram = maxQGram; qGram >= minQGram; --qGram)
+    {
+        if (qGram > options.minLength || qGram >= 1 / options.epsilon)
+            continue;
+
+        StellarOptions candidateOptions = options;
+        candidateOptions.qGram = qGram;
+
+        if (StellarStatistics{candidateOptions}.lossless)
+            candidates.push_back(qGram);
+    }
+
+    return candidates;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Runs the stellar kernel on a random sample of the database for each q-gram length candidate and sets options.qGram
+// to the candidate with the smallest filtering and verification time.
+template <typename TAlphabet, typename TId>
+inline void
+_autoTuneQGram(
+    StringSet<String<TAlphabet>> & databases,
+    StringSet<TId> const & databaseIDs,
+    StringSet<String<TAlphabet>> const & queries,
+    StellarOptions & options)
+{
+    using TDatabaseSegment = stellar::StellarDatabaseSegment<TAlphabet>;
+    using TStorage = std::vector<TDatabaseSegment>;
+
+    constexpr size_t sampleLength = 1000000u;
+    size_t const windowLength = std::max<size_t>(10u * options.minLength, 10000u);
+
+    TStorage databaseSegments = _getDatabaseSegments<TAlphabet, TStorage>(databases, options);
+    TStorage sampleSegments = _sampleDatabaseSegments<TAlphabet>(databaseSegments, sampleLength, windowLength);
+
+    size_t sampledLength{0u};
+    for (TDatabaseSegment const & databaseSegment : sampleSegments)
+        sampledLength += databaseSegment.size();
+
+    std::vector<unsigned> const candidates = _autoTuneQGramCandidates(options);
+    if (candidates.empty())
+        return;
+
+    std::cout << "Auto-tuning k-mer length on " << sampledLength << " sampled database positions:" << std::endl;
+
+    DatabaseIDMap<TAlphabet> databaseIDMap{databases, databaseIDs};
+    QueryIDMap<TAlphabet> queryIDMap{queries};
+
+    unsigned bestQGram = candidates.front();
+    stellar_runtime::duration_t bestTime = stellar_runtime::duration_t::max();
+    for (unsigned const qGram : candidates)
+    {
+        StellarOptions localOptions = options;
+        localOptions.qGram = qGram;
+
+        StellarIndex<TAlphabet> stellarIndex{queries, localOptions};
+        StellarSwiftPattern<TAlphabet> swiftPattern = stellarIndex.createSwiftPattern();
+        stellarIndex.construct();
+
+        // the matches of the sample are discarded, only the running time is of interest
+        StringSet<QueryMatches<StellarMatch<String<TAlphabet> const, TId> > > sampleMatches;
+        resize(sampleMatches, length(queries));
+
+        stellar_kernel_runtime sampleRuntime{};
+        StellarComputeStatistics sampleStatistics{};
+        for (TDatabaseSegment const & databaseSegment : sampleSegments)
+        {
+            sampleStatistics.mergeIn(StellarApp<TAlphabet>::search_and_verify(
+                databaseSegment,
+                databaseIDMap.recordID(databaseSegment),
+                queryIDMap,
+                true,
+                localOptions,
+                swiftPattern,
+                sampleRuntime,
+                sampleMatches));
+        }
+
+        std::cout << "  k-mer length " << qGram
+                  << " : threshold " << StellarStatistics{localOptions}.threshold
+                  << ", " << sampleStatistics.numSwiftHits << " SWIFT hits"
+                  << ", filter " << sampleRuntime.swift_filter_time.milliseconds() << "ms"
+                  << ", verification " << sampleRuntime.verification_time.milliseconds() << "ms" << std::endl;
+
+        stellar_runtime::duration_t const sampleTime = sampleRuntime.total_time()._runtime;
+        if (sampleTime < bestTime)
+        {
+            bestTime = sampleTime;
+            bestQGram = qGram;
+        }
+    }
+
+    options.qGram = bestQGram;
+    std::cout << "  chosen k-mer length : " << bestQGram << std::endl;
+    std::cout << std::endl;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // Creates database segments and calls search_and_verify on each of them
 template <typename TAlphabet, typename TId>
@@ -208,7 +410,7 @@ _stellarMain(
     StringSet<String<TAlphabet>> const & queries,
     StringSet<TId> const & queryIDs,
     StellarOptions const & options,
-    std::ofstream & outputFile,
+    std::ostream & outputFile,
     std::ofstream & disabledQueriesFile,
     stellar_app_runtime & stellar_runtime)
 {
@@ -230,6 +432,12 @@ _stellarMain(
 
     std::vector<size_t> disabledQueryIDs{};
 
+    // optional SWIFT hit counters
+    std::unique_ptr<StellarHitProfile<TAlphabet, TId>> hitProfile{};
+    if (!empty(options.hitReportFile))
+        hitProfile = std::make_unique<StellarHitProfile<TAlphabet, TId>>(databases, databaseIDs, queries,
+                                                                         StellarStatistics{options}.delta);
+
     // compute and print output statistics
     StellarOutputStatistics outputStatistics{};
 
@@ -255,29 +463,39 @@ _stellarMain(
 
             //!TODO: the local stuff is not necessary when working on one thread/segment
             StellarOptions localOptions = options;
+            size_t const strandDisabledQueryIDsBegin = disabledQueryIDs.size();
 
             for (StellarDatabaseSegment<TAlphabet> const & databaseSegment : databaseSegments)
             {
                 size_t const databaseRecordID = databaseIDMap.recordID(databaseSegment);
-                TId const & databaseID = databaseIDMap.databaseID(databaseRecordID);
 
                 StellarComputeStatistics statistics = StellarApp<TAlphabet>::search_and_verify
                 (
                     databaseSegment,
-                    databaseID,
+                    databaseRecordID,
                     queryIDMap,
                     databaseStrand,
                     localOptions,
                     swiftPattern,
                     stellar_runtime.forward_strand_stellar_time.prefiltered_stellar_time,
-                    forwardMatches
+                    forwardMatches,
+                    hitProfile.get()
                 );
 
                 computeStatistics.addStatistics(statistics);
+
+                // the matches of the database record can't change anymore
+                if (options.streamOutput)
+                    _streamQueryMatches(databaseStrand, refLen, options, forwardMatches, databaseIDs, queryIDs,
+                                        strandDisabledQueryIDsBegin, disabledQueryIDs, outputFile, outputStatistics,
+                                        stellar_runtime.forward_strand_stellar_time);
             }
 
             _printStellarStatistics(options.verbose, databaseStrand, databaseIDs, computeStatistics);
 
+            if (options.streamOutput)
+                return;
+
             stellar_runtime.forward_strand_stellar_time.post_process_eps_matches_time.measure_time([&]()
             {
                 // forwardMatches is an in-out parameter
@@ -290,11 +508,11 @@ _stellarMain(
                 stellar_runtime.forward_strand_stellar_time.output_eps_matches_time.measure_time([&]()
                 {
                     // output forwardMatches on positive database strand
-                    _writeAllQueryMatchesToFile(forwardMatches, queryIDs, databaseStrand, options.outputFormat, outputFile);
+                    _writeMatchesToOutputFile(forwardMatches, databaseIDs, queryIDs, databaseStrand, options.outputFormat, outputFile);
                 }); // measure_time
             }
 
-            outputStatistics = _computeOutputStatistics(forwardMatches);
+            outputStatistics.mergeIn(_computeOutputStatistics(forwardMatches));
         }); // measure_time
     }
 
@@ -323,29 +541,39 @@ _stellarMain(
 
             //!TODO: the local stuff is not necessary when working on one thread/segment
             StellarOptions localOptions = options;
+            size_t const strandDisabledQueryIDsBegin = disabledQueryIDs.size();
 
             for (StellarDatabaseSegment<TAlphabet> const & databaseSegment : databaseSegments)
             {
                 size_t const databaseRecordID = databaseIDMap.recordID(databaseSegment);
-                TId const & databaseID = databaseIDMap.databaseID(databaseRecordID);
 
                 StellarComputeStatistics statistics = StellarApp<TAlphabet>::search_and_verify
                 (
                     databaseSegment,
-                    databaseID,
+                    databaseRecordID,
                     queryIDMap,
                     databaseStrand,
                     localOptions,
                     swiftPattern,
                     stellar_runtime.reverse_strand_stellar_time.prefiltered_stellar_time,
-                    reverseMatches
+                    reverseMatches,
+                    hitProfile.get()
                 );
 
                 computeStatistics.addStatistics(statistics);
+
+                // the matches of the database record can't change anymore
+                if (options.streamOutput)
+                    _streamQueryMatches(databaseStrand, refLen, options, reverseMatches, databaseIDs, queryIDs,
+                                        strandDisabledQueryIDsBegin, disabledQueryIDs, outputFile, outputStatistics,
+                                        stellar_runtime.reverse_strand_stellar_time);
             }
 
             _printStellarStatistics(options.verbose, databaseStrand, databaseIDs, computeStatistics);
 
+            if (options.streamOutput)
+                return;
+
             stellar_runtime.reverse_strand_stellar_time.post_process_eps_matches_time.measure_time([&]()
             {
                 _postproccessQueryMatches(databaseStrand, refLen, options, reverseMatches, disabledQueryIDs);
@@ -356,7 +584,7 @@ _stellarMain(
                 stellar_runtime.reverse_strand_stellar_time.output_eps_matches_time.measure_time([&]()
                 {
                     // output reverseMatches on negative database strand
-                    _writeAllQueryMatchesToFile(reverseMatches, queryIDs, databaseStrand, options.outputFormat, outputFile);
+                    _writeMatchesToOutputFile(reverseMatches, databaseIDs, queryIDs, databaseStrand, options.outputFormat, outputFile);
                 }); // measure_time
             }
 
@@ -375,6 +603,19 @@ _stellarMain(
         }); // measure_time
     }
 
+    // Writes the SWIFT hit counters to the hit report file.
+    if (hitProfile)
+    {
+        std::ofstream hitReportFile(toCString(options.hitReportFile), ::std::ios_base::out);
+        if (!hitReportFile.is_open())
+        {
+            std::cerr << "Could not open hit report file." << std::endl;
+            return false;
+        }
+
+        _writeHitProfile(*hitProfile, queryIDs, databaseIDs, options.hitReportTop, hitReportFile);
+    }
+
     _writeOutputStatistics(outputStatistics, options.verbose, disabledQueriesFile.is_open());
 
     return true;
@@ -492,6 +733,28 @@ _importSequenceOfInterest(CharString const & fileName,
     return false;
 }
 
+#if SEQAN_HAS_ZLIB
+///////////////////////////////////////////////////////////////////////////////
+// A BGZF compressed stream on top of the output file. Its blocks are compressed by threadCount compressor threads,
+// seqan's bgzf_ostream can't be given a thread count and always uses the default of basic_bgzf_streambuf.
+// The BGZF end-of-file block is written when the stream buffer is destroyed.
+struct StellarCompressedOutputStream
+{
+    basic_bgzf_streambuf<char> buffer;
+    std::ostream stream;
+
+    StellarCompressedOutputStream(std::ostream & outputFile, size_t const threadCount) :
+        buffer(outputFile, std::max<size_t>(threadCount, 1u)),
+        stream(&buffer)
+    {}
+
+    ~StellarCompressedOutputStream()
+    {
+        stream.flush();
+    }
+};
+#endif // SEQAN_HAS_ZLIB
+
 
 ///////////////////////////////////////////////////////////////////////////////
 // Parses and outputs parameters, calls _stellarMain().
@@ -543,16 +806,46 @@ int mainWithOptions(StellarOptions & options, String<TAlphabet>)
         return 1;
 
     std::cout << std::endl;
+
+    if (options.autoTuneQGram)
+    {
+        stellar_time.auto_tune_time.measure_time([&]()
+        {
+            _autoTuneQGram(databases, databaseIDs, queries, options);
+        }); // measure_time
+
+        // the calculated parameters were written for the computed k-mer length
+        stellar::app::_writeAutoTunedParams(options);
+    }
+
     stellar::app::_writeMoreCalculatedParams(options, refLen, queries);
 
     // open output files
-    std::ofstream outputFile(toCString(options.outputFile), ::std::ios_base::out | ::std::ios_base::app);
+    // a binary match file starts with a header and can't be appended to
+    bool const binaryOutput = options.outputFormat == "smb";
+    std::ofstream outputFile(toCString(options.outputFile), binaryOutput
+                             ? ::std::ios_base::out | ::std::ios_base::binary | ::std::ios_base::trunc
+                             : ::std::ios_base::out | ::std::ios_base::binary | ::std::ios_base::app);
     if (!outputFile.is_open())
     {
         std::cerr << "Could not open output file." << std::endl;
         return 1;
     }
 
+    // the matches are formatted by the main thread(s) and the BGZF blocks are compressed by a pool of threadCount
+    // compressor threads
+#if SEQAN_HAS_ZLIB
+    std::unique_ptr<StellarCompressedOutputStream> compressedOutputFile{};
+    if (options.compressOutput)
+        compressedOutputFile = std::make_unique<StellarCompressedOutputStream>(outputFile, options.threadCount);
+    std::ostream & matchesFile = compressedOutputFile ? compressedOutputFile->stream : static_cast<std::ostream &>(outputFile);
+#else
+    std::ostream & matchesFile = outputFile;
+#endif // SEQAN_HAS_ZLIB
+
+    if (binaryOutput)
+        _writeBinaryMatchesHeader<TAlphabet>(databaseIDs, queryIDs, matchesFile);
+
     std::ofstream disabledQueriesFile;
     if (options.disableThresh != std::numeric_limits<unsigned>::max())
     {
@@ -565,7 +858,7 @@ int mainWithOptions(StellarOptions & options, String<TAlphabet>)
     }
 
     // stellar on all databases and queries writing results to file
-    if (!_stellarMain(databases, databaseIDs, refLen, queries, queryIDs, options, outputFile, disabledQueriesFile, stellar_time))
+    if (!_stellarMain(databases, databaseIDs, refLen, queries, queryIDs, options, matchesFile, disabledQueriesFile, stellar_time))
         return 1;
 
     if (options.verbose && options.noRT == false)
@@ -586,8 +879,11 @@ int mainWithOptions(StellarOptions & options, String<TAlphabet>)
             std::cout << "       + Prefiltered Stellar Time (" << strandDirection << "): " << prefiltered_stellar_time.milliseconds() << "ms" << std::endl;
             std::cout << "          + Swift Filter Time (" << strandDirection << "): " << prefiltered_stellar_time.swift_filter_time.milliseconds() << "ms" << std::endl;
             std::cout << "          + Seed Verification Time (" << strandDirection << "): " << verification_time.milliseconds() << "ms" << std::endl;
+            std::cout << "             + Batch Banded Local Score Time (" << strandDirection << "): " << verification_time.banded_local_score_time.milliseconds() << "ms" << std::endl;
+            std::cout << "             + Precheck Time (" << strandDirection << "): " << verification_time.precheck_time.milliseconds() << "ms" << std::endl;
             std::cout << "             + Find Next Local Alignment Time (" << strandDirection << "): " << verification_time.next_local_alignment_time.milliseconds() << "ms" << std::endl;
             std::cout << "             + Split At X-Drops Time (" << strandDirection << "): " << verification_time.split_at_x_drops_time.milliseconds() << "ms" << std::endl;
+            std::cout << "             + Banded Global Alignment Time (" << strandDirection << "): " << verification_time.banded_global_alignment_time.milliseconds() << "ms" << std::endl;
             std::cout << "             + Extension Time (" << strandDirection << "): " << extension_time.milliseconds() << "ms" << std::endl;
             std::cout << "                + Extend Seed Time (" << strandDirection << "): " << extension_time.extend_seed_time.milliseconds() << "ms" << std::endl;
             std::cout << "                + Best Extension Time (" << strandDirection << "): " << best_extension_time.milliseconds() << "ms" << std::endl;
@@ -609,6 +905,7 @@ int mainWithOptions(StellarOptions & options, String<TAlphabet>)
         std::cout << " * Stellar Application Time: " << stellar_time.milliseconds() << "ms" << std::endl;
         std::cout << "    + File Input Queries Time: " << stellar_time.input_queries_time.milliseconds() << "ms" << std::endl;
         std::cout << "    + File Input Databases Time: " << stellar_time.input_databases_time.milliseconds() << "ms" << std::endl;
+        std::cout << "    + Auto-Tune K-mer Length Time: " << stellar_time.auto_tune_time.milliseconds() << "ms" << std::endl;
         std::cout << "    + SwiftFilter Construction Time: " << stellar_time.swift_index_construction_time.milliseconds() << "ms" << std::endl;
         std::cout << "    + Stellar Forward Strand Time: " << stellar_time.forward_strand_stellar_time.milliseconds() << "ms" << std::endl;
         _print_stellar_strand_time(stellar_time.forward_strand_stellar_time, "Forward");
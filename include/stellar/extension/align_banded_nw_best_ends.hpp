@@ -1,23 +1,83 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
 #include <seqan/seeds.h>
 
+#include <stellar/extension/extension_packed_trace.hpp>
+#include <stellar/extension/unit_match_score.hpp>
+
 namespace stellar
 {
 using namespace seqan;
 
+///////////////////////////////////////////////////////////////////////////////
+// Buffers of _align_banded_nw_best_ends, they keep their capacity between calls.
+template <typename TScoreValue>
+struct AlignBandedNwBestEndsBuffers
+{
+    // row-wise kernel: scores and alignment lengths of one row
+    // anti-diagonal kernel: scores and alignment lengths of the last three anti-diagonals
+    String<TScoreValue> scores{};
+    String<TScoreValue> lengths{};
+
+    // anti-diagonal kernel only
+    String<int32_t> rowCharacters{};
+    String<int32_t> reversedColumnCharacters{};
+    String<int32_t> traceLanes{};
+    String<int32_t> errorLanes{};
+    String<TScoreValue> bestLengths{};
+    String<int64_t> bestPositions{};
+};
+
+// number of anti-diagonal cells that _align_banded_nw_best_ends_antidiagonal computes at once
+constexpr size_t _antidiagonalLaneCount = 4u;
+
+using AntidiagonalVector = int32_t __attribute__((vector_size(_antidiagonalLaneCount * sizeof(int32_t))));
+using AntidiagonalFloatVector = float __attribute__((vector_size(_antidiagonalLaneCount * sizeof(float))));
+
+inline AntidiagonalVector
+_loadAntidiagonalVector(int32_t const * values)
+{
+    AntidiagonalVector vector;
+    std::memcpy(&vector, values, sizeof(vector));
+    return vector;
+}
+
+inline void
+_storeAntidiagonalVector(int32_t * values, AntidiagonalVector const & vector)
+{
+    std::memcpy(values, &vector, sizeof(vector));
+}
+
+// (mask ? a : b) for each lane
+inline AntidiagonalVector
+_selectAntidiagonalVector(AntidiagonalVector const & mask,
+                          AntidiagonalVector const & a,
+                          AntidiagonalVector const & b)
+{
+    return (a & mask) | (b & ~mask);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // Computes the banded alignment matrix and additionally a string with the best
 //   alignment end point for each alignment length.
+// Row-wise scalar kernel, see _align_banded_nw_best_ends.
 template <typename TTrace, typename TEnd, typename TStringSet, typename TScore, typename TDiagonal>
 inline void
-_align_banded_nw_best_ends(TTrace& trace,
-                           String<TEnd> & bestEnds,
-                           TStringSet const & str,
-                           TScore const & sc,
-                           TDiagonal const diagL,
-                           TDiagonal const diagU)
+_align_banded_nw_best_ends_rowwise(TTrace& trace,
+                                   String<TEnd> & bestEnds,
+                                   TStringSet const & str,
+                                   TScore const & sc,
+                                   TDiagonal const diagL,
+                                   TDiagonal const diagU,
+                                   AlignBandedNwBestEndsBuffers<typename Value<TScore>::Type> & buffers)
 {
     typedef typename Value<TTrace>::Type TTraceValue;
     typedef typename Value<TScore>::Type TScoreValue;
@@ -54,14 +114,17 @@ _align_banded_nw_best_ends(TTrace& trace,
     TSize const height = hi_row - lo_row;
 
     typedef String<TScoreValue> TRow;
-    TRow mat, len;
-    resize(mat, diagonalWidth);
-    resize(len, diagonalWidth);
-    resize(trace, height * diagonalWidth);
+    TRow & mat = buffers.scores;
+    TRow & len = buffers.lengths;
+    // the buffers might hold values of a previous call
+    clear(mat);
+    clear(len);
+    resize(mat, diagonalWidth, TScoreValue{});
+    resize(len, diagonalWidth, TScoreValue{});
+    _resizeTrace(trace, height * diagonalWidth);
 
     // Classical DP with affine gap costs
     typedef typename Iterator<TRow, Standard>::Type TRowIter;
-    typedef typename Iterator<TTrace, Standard>::Type TTraceIter;
 
     TSize errors;
 
@@ -77,14 +140,14 @@ _align_banded_nw_best_ends(TTrace& trace,
         TSize actualRow = row + lo_row;
         if (lo_diag > 0) --lo_diag;
         if ((TDiagonal)actualRow >= (TDiagonal)len1 - diagU) --hi_diag;
-        TTraceIter traceIt = begin(trace, Standard()) + row * diagonalWidth + lo_diag;
+        TSize tracePosition = row * diagonalWidth + lo_diag;
         TRowIter current_score_rowise_it = begin(mat, Standard()) + lo_diag;
         TRowIter alignment_length_it = begin(len, Standard()) + lo_diag;
 
         TScoreValue score_left = std::numeric_limits<TScoreValue>::min();
         TScoreValue alignment_length_left = len1+len2+1;
 
-        for(TSize col = lo_diag; col<hi_diag; ++col, ++current_score_rowise_it, ++traceIt, ++alignment_length_it) {
+        for(TSize col = lo_diag; col<hi_diag; ++col, ++current_score_rowise_it, ++tracePosition, ++alignment_length_it) {
             TSize actualCol = col + diagL + actualRow;
             if (actualCol >= len1) break;
 
@@ -94,7 +157,7 @@ _align_banded_nw_best_ends(TTrace& trace,
 
                 // Get the new maximum for mat
                 *current_score_rowise_it += score(sc, str1entry, str2entry);
-                *traceIt = Diagonal;
+                TTraceValue traceValue = Diagonal;
                 ++(*alignment_length_it);
 
                 TScoreValue score_up =
@@ -105,7 +168,7 @@ _align_banded_nw_best_ends(TTrace& trace,
                 if (score_up > *current_score_rowise_it)
                 {
                     *current_score_rowise_it = score_up;
-                    *traceIt = Vertical;
+                    traceValue = Vertical;
                     *alignment_length_it = *(alignment_length_it+1) + 1;
                 }
 
@@ -116,9 +179,10 @@ _align_banded_nw_best_ends(TTrace& trace,
                 if (score_left > *current_score_rowise_it)
                 {
                     *current_score_rowise_it = score_left;
-                    *traceIt = Horizontal;
+                    traceValue = Horizontal;
                     *alignment_length_it = alignment_length_left + 1;
                 }
+                _assignTraceValue(trace, tracePosition, traceValue);
                 score_left = *current_score_rowise_it;
                 alignment_length_left = *alignment_length_it;
             } else {
@@ -168,4 +232,443 @@ _align_banded_nw_best_ends(TTrace& trace,
     resize(bestEnds, newLength + 1);
 }
 
+
+///////////////////////////////////////////////////////////////////////////////
+// Computes the same trace matrix and best ends as _align_banded_nw_best_ends_rowwise, but computes the cells of each
+// anti-diagonal (actualRow + actualColumn = d) in SIMD lanes. The cells of an anti-diagonal only depend on the two
+// previous anti-diagonals. The best end of each error count is reduced afterwards from the cells of the anti-diagonal:
+// the longest alignment and among those the first cell in row-major order, like the row-wise kernel would pick it.
+// Needs diagL <= 0 <= diagU and scores that can't overflow 32 bit.
+template <typename TTrace, typename TEnd, typename TStringSet, typename TScore, typename TDiagonal>
+inline void
+_align_banded_nw_best_ends_antidiagonal(TTrace& trace,
+                                        String<TEnd> & bestEnds,
+                                        TStringSet const & str,
+                                        TScore const & sc,
+                                        TDiagonal const diagL,
+                                        TDiagonal const diagU,
+                                        AlignBandedNwBestEndsBuffers<typename Value<TScore>::Type> & buffers)
+{
+    typedef typename Value<TTrace>::Type TTraceValue;
+    typedef typename Value<TScore>::Type TScoreValue;
+    typedef typename Value<TStringSet>::Type TString;
+    using TVector = AntidiagonalVector;
+    using TFloatVector = AntidiagonalFloatVector;
+    static_assert(std::is_same_v<TScoreValue, int32_t>, "The anti-diagonal kernel computes 32 bit scores.");
+
+    SEQAN_ASSERT_LEQ(diagL, 0);
+    SEQAN_ASSERT_GEQ(diagU, 0);
+
+    // Initialization
+    TTraceValue const Horizontal = 1;
+    TTraceValue const Vertical = 2;
+    TString const& str1 = str[0];
+    TString const& str2 = str[1];
+    int64_t const len1 = length(str1) + 1;
+    int64_t const len2 = length(str2) + 1;
+    int64_t const diagonalWidth = diagU - diagL + 1;
+    int64_t const hi_row = std::min<int64_t>(len2, len1 - diagL); // lo_row is 0, because diagU >= 0
+    int64_t const laneCount = _antidiagonalLaneCount;
+
+    TScoreValue const matchScore = scoreMatch(sc);
+    TScoreValue const gapScore = scoreGap(sc);
+    TScoreValue const outsideOfBand = std::numeric_limits<TScoreValue>::min() / 2;
+
+    _resizeTrace(trace, hi_row * diagonalWidth);
+    clear(bestEnds);
+
+    // scores and lengths of the anti-diagonals d, d - 1, d - 2; the cell in actualRow is at index actualRow + 1
+    int64_t const bufferLength = hi_row + 1 + laneCount;
+    clear(buffers.scores);
+    clear(buffers.lengths);
+    resize(buffers.scores, 3 * bufferLength, outsideOfBand);
+    resize(buffers.lengths, 3 * bufferLength, TScoreValue{});
+
+    // rowCharacters[actualRow] = str2[actualRow - 1] and
+    // reversedColumnCharacters[len1 - 1 - actualColumn + hi_row] = str1[actualColumn - 1], such that the characters
+    // of an anti-diagonal are consecutive in both; different sentinels never match
+    clear(buffers.rowCharacters);
+    clear(buffers.reversedColumnCharacters);
+    resize(buffers.rowCharacters, hi_row + laneCount, -1);
+    resize(buffers.reversedColumnCharacters, len1 + hi_row + laneCount, -2);
+    for (int64_t actualRow = 1; actualRow < hi_row; ++actualRow)
+        buffers.rowCharacters[actualRow] = ordValue(str2[actualRow - 1]);
+    for (int64_t actualColumn = 1; actualColumn < len1; ++actualColumn)
+        buffers.reversedColumnCharacters[len1 - 1 - actualColumn + hi_row] = ordValue(str1[actualColumn - 1]);
+
+    resize(buffers.traceLanes, hi_row + laneCount);
+    resize(buffers.errorLanes, hi_row + laneCount);
+    clear(buffers.bestLengths);
+    clear(buffers.bestPositions);
+
+    // keeps the longest cell of an error count, ties are won by the first cell in row-major order
+    auto updateBestEnd = [&](int64_t const errors, TScoreValue const cellLength, int64_t const row, int64_t const col)
+    {
+        if (errors >= (int64_t)length(buffers.bestLengths))
+        {
+            resize(buffers.bestLengths, errors + 1, TScoreValue{-1});
+            resize(buffers.bestPositions, errors + 1, int64_t{0});
+            resize(bestEnds, errors + 1);
+        }
+
+        int64_t const position = row * diagonalWidth + col;
+        if (cellLength > buffers.bestLengths[errors] ||
+            (cellLength == buffers.bestLengths[errors] && position < buffers.bestPositions[errors]))
+        {
+            buffers.bestLengths[errors] = cellLength;
+            buffers.bestPositions[errors] = position;
+            bestEnds[errors] = TEnd(cellLength, row, col);
+        }
+    };
+
+    auto ceilHalf = [](int64_t const x) { return (x >= 0) ? (x + 1) / 2 : -((-x) / 2); };
+    auto floorHalf = [](int64_t const x) { return (x >= 0) ? x / 2 : -((-x + 1) / 2); };
+
+    TVector const matchVector = TVector{} + matchScore;
+    TVector const gapVector = TVector{} + gapScore;
+    TVector const oneVector = TVector{} + 1;
+    TVector const verticalVector = TVector{} + Vertical;
+    TVector const horizontalVector = TVector{} + Horizontal;
+    // errors = (length * matchScore - score) / (matchScore - gapScore), the division is exact
+    float const inverseErrorScore = 1.0f / (matchScore - gapScore);
+
+    for (int64_t d = 0; d < hi_row + len1 - 1; ++d)
+    {
+        // cells of the anti-diagonal inside of the matrix and the band (diagL <= actualColumn - actualRow <= diagU)
+        int64_t const rowBegin = std::max({int64_t{0}, d - len1 + 1, ceilHalf(d - diagU)});
+        int64_t const rowEnd = std::min({hi_row - 1, d, floorHalf(d - diagL)}) + 1;
+        if (rowBegin >= rowEnd)
+            continue;
+
+        TScoreValue * current = begin(buffers.scores, Standard()) + (d % 3) * bufferLength;
+        TScoreValue const * previous = begin(buffers.scores, Standard()) + ((d + 2) % 3) * bufferLength;
+        TScoreValue const * previous2 = begin(buffers.scores, Standard()) + ((d + 1) % 3) * bufferLength;
+        TScoreValue * currentLength = begin(buffers.lengths, Standard()) + (d % 3) * bufferLength;
+        TScoreValue const * previousLength = begin(buffers.lengths, Standard()) + ((d + 2) % 3) * bufferLength;
+        TScoreValue const * previous2Length = begin(buffers.lengths, Standard()) + ((d + 1) % 3) * bufferLength;
+        int32_t const * columnCharacters = begin(buffers.reversedColumnCharacters, Standard()) + len1 - 1 - d + hi_row;
+
+        for (int64_t actualRow = rowBegin; actualRow < rowEnd; actualRow += laneCount)
+        {
+            // diagonal (actualRow - 1, actualColumn - 1), vertical (actualRow - 1, actualColumn) and horizontal
+            // (actualRow, actualColumn - 1) predecessors, with the same tie breaking as the row-wise kernel
+            TVector const equal = _loadAntidiagonalVector(begin(buffers.rowCharacters, Standard()) + actualRow)
+                               == _loadAntidiagonalVector(columnCharacters + actualRow);
+            TVector score = _loadAntidiagonalVector(previous2 + actualRow)
+                          + _selectAntidiagonalVector(equal, matchVector, gapVector);
+            TVector alignmentLength = _loadAntidiagonalVector(previous2Length + actualRow) + oneVector;
+            TVector traceValue = TVector{}; // Diagonal
+
+            TVector const scoreUp = _loadAntidiagonalVector(previous + actualRow) + gapVector;
+            TVector const up = scoreUp > score;
+            score = _selectAntidiagonalVector(up, scoreUp, score);
+            alignmentLength = _selectAntidiagonalVector(up, _loadAntidiagonalVector(previousLength + actualRow) + oneVector,
+                                                        alignmentLength);
+            traceValue = _selectAntidiagonalVector(up, verticalVector, traceValue);
+
+            TVector const scoreLeft = _loadAntidiagonalVector(previous + actualRow + 1) + gapVector;
+            TVector const left = scoreLeft > score;
+            score = _selectAntidiagonalVector(left, scoreLeft, score);
+            alignmentLength = _selectAntidiagonalVector(left, _loadAntidiagonalVector(previousLength + actualRow + 1) + oneVector,
+                                                        alignmentLength);
+            traceValue = _selectAntidiagonalVector(left, horizontalVector, traceValue);
+
+            TFloatVector const errors = __builtin_convertvector(alignmentLength * matchVector - score, TFloatVector)
+                                      * inverseErrorScore + 0.5f;
+
+            _storeAntidiagonalVector(current + actualRow + 1, score);
+            _storeAntidiagonalVector(currentLength + actualRow + 1, alignmentLength);
+            _storeAntidiagonalVector(begin(buffers.traceLanes, Standard()) + actualRow - rowBegin, traceValue);
+            _storeAntidiagonalVector(begin(buffers.errorLanes, Standard()) + actualRow - rowBegin,
+                                     __builtin_convertvector(errors, TVector));
+        }
+
+        // usual initialization for first row and column
+        int64_t laneBegin = rowBegin;
+        int64_t laneEnd = rowEnd;
+        auto initializeCell = [&](int64_t const actualRow, int64_t const cellLength)
+        {
+            current[actualRow + 1] = cellLength * gapScore;
+            currentLength[actualRow + 1] = cellLength;
+            updateBestEnd(cellLength, cellLength, actualRow, d - actualRow - diagL - actualRow);
+        };
+        if (rowBegin == 0)
+            initializeCell(laneBegin++, d);
+        if (rowEnd == d + 1 && laneBegin < laneEnd)
+            initializeCell(--laneEnd, d);
+
+        // write trace and reduce best ends
+        if (laneBegin < laneEnd)
+        {
+            int64_t tracePosition = laneBegin * diagonalWidth + (d - laneBegin - diagL - laneBegin);
+            for (int64_t actualRow = laneBegin; actualRow < laneEnd; ++actualRow, tracePosition += diagonalWidth - 2)
+            {
+                int64_t const lane = actualRow - rowBegin;
+                _assignTraceValue(trace, tracePosition, static_cast<TTraceValue>(buffers.traceLanes[lane]));
+
+                TScoreValue const cellLength = currentLength[actualRow + 1];
+                int64_t const errors = buffers.errorLanes[lane];
+                if (errors >= (int64_t)length(buffers.bestLengths) || cellLength >= buffers.bestLengths[errors])
+                    updateBestEnd(errors, cellLength, actualRow, d - actualRow - diagL - actualRow);
+            }
+        }
+
+        // the cells next to the anti-diagonal are outside of the band
+        current[rowBegin] = outsideOfBand;
+        current[rowEnd + 1] = outsideOfBand;
+    }
+
+    SEQAN_ASSERT(std::find(begin(buffers.bestLengths), end(buffers.bestLengths), TScoreValue{-1}) == end(buffers.bestLengths));
+
+    size_t newLength = length(bestEnds) - 1;
+    while (newLength > 0 && bestEnds[newLength].length <= bestEnds[newLength-1].length) {
+        --newLength;
+    }
+    resize(bestEnds, newLength + 1);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Computes the banded alignment matrix and additionally a string with the best
+//   alignment end point for each alignment length.
+// Uses the anti-diagonal SIMD kernel for wide bands, otherwise the row-wise kernel.
+// All kernels take a seqan::Score or a UnitMatchScore, with the latter the compiler knows the match score.
+template <typename TTrace, typename TEnd, typename TStringSet, typename TScore, typename TDiagonal>
+inline void
+_align_banded_nw_best_ends(TTrace& trace,
+                           String<TEnd> & bestEnds,
+                           TStringSet const & str,
+                           TScore const & sc,
+                           TDiagonal const diagL,
+                           TDiagonal const diagU,
+                           AlignBandedNwBestEndsBuffers<typename Value<TScore>::Type> & buffers)
+{
+    typedef typename Value<TScore>::Type TScoreValue;
+
+    // anti-diagonals are at most half as long as the band is wide
+    constexpr TDiagonal minAntidiagonalBandWidth = 4 * _antidiagonalLaneCount;
+    int64_t const maxAbsoluteScore = (int64_t)(length(str[0]) + length(str[1]) + 2)
+                                   * std::max<int64_t>(std::abs(scoreMatch(sc)), std::abs(scoreGap(sc)));
+
+    if constexpr (std::is_same_v<TScoreValue, int32_t>)
+    {
+        if (diagL <= 0 && diagU >= 0 && diagU - diagL + 1 >= minAntidiagonalBandWidth &&
+            maxAbsoluteScore < std::numeric_limits<int32_t>::max() / 4)
+        {
+            _align_banded_nw_best_ends_antidiagonal(trace, bestEnds, str, sc, diagL, diagU, buffers);
+            return;
+        }
+    }
+
+    _align_banded_nw_best_ends_rowwise(trace, bestEnds, str, sc, diagL, diagU, buffers);
+}
+
+template <typename TTrace, typename TEnd, typename TStringSet, typename TScore, typename TDiagonal>
+inline void
+_align_banded_nw_best_ends(TTrace& trace,
+                           String<TEnd> & bestEnds,
+                           TStringSet const & str,
+                           TScore const & sc,
+                           TDiagonal const diagL,
+                           TDiagonal const diagU)
+{
+    AlignBandedNwBestEndsBuffers<typename Value<TScore>::Type> buffers{};
+    _align_banded_nw_best_ends(trace, bestEnds, str, sc, diagL, diagU, buffers);
+}
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Computes the banded alignment matrix and the best ends like _align_banded_nw_best_ends, but prunes the band
+//   adaptively like the X-drop DP of BLAST: a cell whose score falls below the best score so far minus
+//   scoreDropOff is dropped and no alignment continues through it. Each row only computes the cells that are
+//   reachable from the alive cells of the previous row, i.e. one cell left of them up to the last alive cell.
+// Alive cells only continue alignments of alive cells, the best ends only consider alive cells. Without any dropped
+//   cell, trace and best ends are the same as of the row-wise kernel. For near-identical sequences only a few cells
+//   per row stay alive, independent of the band width.
+template <typename TTrace, typename TEnd, typename TStringSet, typename TScore, typename TDiagonal>
+inline void
+_align_banded_nw_best_ends_xdrop_rowwise(TTrace& trace,
+                                         String<TEnd> & bestEnds,
+                                         TStringSet const & str,
+                                         TScore const & sc,
+                                         TDiagonal const diagL,
+                                         TDiagonal const diagU,
+                                         typename Value<TScore>::Type const scoreDropOff,
+                                         AlignBandedNwBestEndsBuffers<typename Value<TScore>::Type> & buffers)
+{
+    typedef typename Value<TTrace>::Type TTraceValue;
+    typedef typename Value<TScore>::Type TScoreValue;
+    typedef typename Value<TStringSet>::Type TString;
+    typedef typename Value<TString>::Type TAlphabet;
+
+    SEQAN_ASSERT_GEQ(diagU, diagL);
+    SEQAN_ASSERT_GEQ(scoreDropOff, 0);
+    SEQAN_ASSERT_EQ(scoreMismatch(sc), scoreGap(sc));
+
+    // Initialization
+    TTraceValue const Diagonal = 0;
+    TTraceValue const Horizontal = 1;
+    TTraceValue const Vertical = 2;
+    TString const& str1 = str[0];
+    TString const& str2 = str[1];
+    int64_t const len1 = length(str1) + 1;
+    int64_t const len2 = length(str2) + 1;
+    int64_t const diagonalWidth = diagU - diagL + 1;
+    int64_t const lo_row = (diagU <= 0) ? -diagU : 0;
+    SEQAN_ASSERT_GEQ(len1, diagL);
+    int64_t const hi_row = std::min<int64_t>(len2, len1 - diagL);
+
+    TScoreValue const matchScore = scoreMatch(sc);
+    TScoreValue const gapScore = scoreGap(sc);
+    TScoreValue const dropped = std::numeric_limits<TScoreValue>::min() / 2;
+
+    // scores and alignment lengths of the last row by diagonal; dropped cells and cells that were not computed have
+    // the score dropped, the additional last cell is the (always dropped) cell above the band
+    TScoreValue * mat;
+    TScoreValue * len;
+    clear(buffers.scores);
+    clear(buffers.lengths);
+    resize(buffers.scores, diagonalWidth + 1, dropped);
+    resize(buffers.lengths, diagonalWidth + 1, TScoreValue{});
+    mat = begin(buffers.scores, Standard());
+    len = begin(buffers.lengths, Standard());
+
+    _resizeTrace(trace, (hi_row - lo_row) * diagonalWidth);
+    clear(bestEnds);
+
+    int64_t bestScore = 0;
+    // alive cells of the previous row; the first row has only initialization cells, which get worse from left to
+    // right, so it stops at its first dropped cell
+    int64_t aliveBegin = 0;
+    int64_t aliveEnd = 0;
+
+    for (int64_t actualRow = lo_row; actualRow < hi_row; ++actualRow)
+    {
+        int64_t const row = actualRow - lo_row;
+        int64_t const colBegin = std::max<int64_t>({0, -(diagL + actualRow), aliveBegin - 1});
+        int64_t const colEnd = std::min<int64_t>(diagonalWidth, len1 - diagL - actualRow);
+
+        TScoreValue score_left = dropped;
+        TScoreValue alignment_length_left = 0;
+        int64_t nextAliveBegin = colEnd;
+        int64_t nextAliveEnd = colBegin;
+
+        int64_t col = colBegin;
+        for (; col < colEnd; ++col)
+        {
+            int64_t const actualCol = col + diagL + actualRow;
+            TScoreValue cellScore;
+            TScoreValue alignmentLength;
+
+            if ((actualRow != 0) && (actualCol != 0))
+            {
+                // same tie breaking as the row-wise kernel: diagonal, vertical, horizontal
+                TAlphabet const str1entry = sequenceEntryForScore(sc, str1, actualCol - 1);
+                TAlphabet const str2entry = sequenceEntryForScore(sc, str2, actualRow - 1);
+                cellScore = mat[col] + score(sc, str1entry, str2entry);
+                alignmentLength = len[col] + 1;
+                TTraceValue traceValue = Diagonal;
+
+                TScoreValue const score_up = mat[col + 1] + gapScore;
+                if (score_up > cellScore)
+                {
+                    cellScore = score_up;
+                    alignmentLength = len[col + 1] + 1;
+                    traceValue = Vertical;
+                }
+
+                TScoreValue const score_horizontal = score_left + gapScore;
+                if (score_horizontal > cellScore)
+                {
+                    cellScore = score_horizontal;
+                    alignmentLength = alignment_length_left + 1;
+                    traceValue = Horizontal;
+                }
+
+                _assignTraceValue(trace, row * diagonalWidth + col, traceValue);
+            }
+            else
+            {
+                // Usual initialization for first row and column
+                alignmentLength = static_cast<TScoreValue>(std::max(actualRow, actualCol));
+                cellScore = alignmentLength * gapScore;
+            }
+
+            if (cellScore < bestScore - scoreDropOff)
+            {
+                // X-drop: no alignment continues through this cell, the cells right of the previous row's alive
+                // cells can only be reached through this one
+                mat[col] = dropped;
+                score_left = dropped;
+                if (col >= aliveEnd)
+                {
+                    ++col;
+                    break;
+                }
+                continue;
+            }
+
+            mat[col] = cellScore;
+            len[col] = alignmentLength;
+            score_left = cellScore;
+            alignment_length_left = alignmentLength;
+            bestScore = std::max<int64_t>(bestScore, cellScore);
+            nextAliveBegin = std::min(nextAliveBegin, col);
+            nextAliveEnd = col + 1;
+
+            // see _align_banded_nw_best_ends_rowwise
+            size_t const errors = (cellScore - (alignmentLength * matchScore)) / (gapScore - matchScore);
+            SEQAN_ASSERT_LEQ(errors, length(bestEnds));
+            if (errors == length(bestEnds))
+                appendValue(bestEnds, TEnd(alignmentLength, row, col));
+            else if (alignmentLength > static_cast<TScoreValue>(bestEnds[errors].length))
+                bestEnds[errors] = TEnd(alignmentLength, row, col);
+        }
+
+        // cells of the previous row that this row didn't compute
+        for (int64_t staleCol = col; staleCol < aliveEnd; ++staleCol)
+            mat[staleCol] = dropped;
+
+        if (nextAliveBegin >= nextAliveEnd)
+            break; // all cells of the row were dropped, so are all following rows
+
+        aliveBegin = nextAliveBegin;
+        aliveEnd = nextAliveEnd;
+    }
+
+    SEQAN_ASSERT_NOT(empty(bestEnds));
+    size_t newLength = length(bestEnds) - 1;
+    while (newLength > 0 && bestEnds[newLength].length <= bestEnds[newLength-1].length) {
+        --newLength;
+    }
+    resize(bestEnds, newLength + 1);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Computes the banded alignment matrix and the best ends with X-drop pruning.
+// A cell scores at least scoreGap * max(row, column) and no cell scores more than scoreMatch * min(row, column). If
+//   the drop-off exceeds the difference, no cell can be dropped and the result is the one of
+//   _align_banded_nw_best_ends, which then computes the band with the anti-diagonal SIMD kernel. Otherwise the
+//   scalar X-drop kernel prunes the band.
+template <typename TTrace, typename TEnd, typename TStringSet, typename TScore, typename TDiagonal>
+inline void
+_align_banded_nw_best_ends_xdrop(TTrace& trace,
+                                 String<TEnd> & bestEnds,
+                                 TStringSet const & str,
+                                 TScore const & sc,
+                                 TDiagonal const diagL,
+                                 TDiagonal const diagU,
+                                 typename Value<TScore>::Type const scoreDropOff,
+                                 AlignBandedNwBestEndsBuffers<typename Value<TScore>::Type> & buffers)
+{
+    int64_t const length1 = length(str[0]);
+    int64_t const length2 = length(str[1]);
+    int64_t const maxScoreDifference = std::min(length1, length2) * static_cast<int64_t>(scoreMatch(sc))
+                                     - std::max(length1, length2) * static_cast<int64_t>(scoreGap(sc));
+
+    if (maxScoreDifference <= static_cast<int64_t>(scoreDropOff))
+        _align_banded_nw_best_ends(trace, bestEnds, str, sc, diagL, diagU, buffers);
+    else
+        _align_banded_nw_best_ends_xdrop_rowwise(trace, bestEnds, str, sc, diagL, diagU, scoreDropOff, buffers);
+}
+
 } // namespace stellar
@@ -2,18 +2,24 @@
 #pragma once
 
 #include <span>
+#include <type_traits>
 
 #include <seqan/sequence.h>
 #include <seqan/align/align_traceback.h> // needs seqan/sequence.h
 
+#include <stellar/extension/extension_packed_trace.hpp>
+
 namespace stellar
 {
 
-struct extension_banded_trace_matrix
+// TTraceMatrix is either a seqan::String<seqan::TraceBack> (one byte per cell) or an extension_packed_trace (two
+// bits per cell). rowSpan and data return a std::span<seqan::TraceBack> or an extension_packed_trace_span.
+template <typename TTraceMatrix>
+struct basic_extension_banded_trace_matrix
 {
     using diagonal_t = std::make_signed_t<size_t>;
 
-    extension_banded_trace_matrix(
+    basic_extension_banded_trace_matrix(
         size_t const rowCount,
         size_t const columnCount,
         diagonal_t const lowerDiagonal,
@@ -27,7 +33,7 @@ struct extension_banded_trace_matrix
     {
         assert(lowerDiagonal <= upperDiagonal);
 
-        resize(_traceMatrix, dataSize());
+        _resizeTrace(_traceMatrix, dataSize());
     }
 
     size_t rows() const
@@ -56,11 +62,11 @@ struct extension_banded_trace_matrix
     }
 
     // memory region for active row
-    std::span<seqan::TraceBack> rowSpan(size_t const row)
+    auto rowSpan(size_t const row)
     {
         auto [beginRow, endRow] = rowInterval();
         if (!(beginRow <= row && row <= endRow))
-            return {};
+            return decltype(data()){};
 
         size_t rowOffset = row - beginRow;
         auto diagonalInterval = diagonalIntervalInRow(row);
@@ -73,13 +79,20 @@ struct extension_banded_trace_matrix
     }
 
     // complete underlying data
-    std::span<seqan::TraceBack> data()
+    auto data()
     {
-        seqan::TraceBack & firstValue = *begin(_traceMatrix);
-        return {&firstValue, dataSize()};
+        if constexpr (std::is_same_v<TTraceMatrix, extension_packed_trace>)
+        {
+            return extension_packed_trace_span{&_traceMatrix, 0u, dataSize()};
+        }
+        else
+        {
+            seqan::TraceBack & firstValue = *begin(_traceMatrix);
+            return std::span<seqan::TraceBack>{&firstValue, dataSize()};
+        }
     }
 
-    seqan::String<seqan::TraceBack> & underlyingTraceMatrix()
+    TTraceMatrix & underlyingTraceMatrix()
     {
         return _traceMatrix;
     }
@@ -151,7 +164,10 @@ private:
     diagonal_t _lowerDiagonal;
     diagonal_t _upperDiagonal;
 
-    seqan::String<seqan::TraceBack> _traceMatrix;
+    TTraceMatrix _traceMatrix;
 };
 
+using extension_banded_trace_matrix = basic_extension_banded_trace_matrix<seqan::String<seqan::TraceBack>>;
+using extension_packed_banded_trace_matrix = basic_extension_banded_trace_matrix<extension_packed_trace>;
+
 }
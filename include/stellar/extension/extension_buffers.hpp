@@ -0,0 +1,52 @@
+
+#pragma once
+
+#include <seqan/align.h>
+#include <seqan/modifier.h>
+
+#include <stellar/extension/align_banded_nw_best_ends.hpp>
+#include <stellar/extension/extension_end_position.hpp>
+#include <stellar/extension/extension_packed_trace.hpp>
+#include <stellar/extension/longest_eps_match.hpp>
+
+namespace stellar
+{
+using namespace seqan;
+
+///////////////////////////////////////////////////////////////////////////////
+// Buffers of _extendAndExtract and _bestExtension. They are cleared before each use, but keep their capacity such
+// that extending many eps-cores doesn't allocate memory over and over again.
+template <typename TSequence>
+struct StellarExtensionBuffers
+{
+    using TPos = typename Position<TSequence>::Type;
+    using TInfix = Segment<TSequence const, InfixSegment>;
+    using TReverseInfix = ModifiedString<TInfix, ModReverse>;
+
+    // banded trace matrices (2 bit per cell) and best ends of the left and right extension
+    extension_packed_trace matrixLeft{};
+    extension_packed_trace matrixRight{};
+    String<ExtensionEndPosition<TPos> > possibleEndsLeft{};
+    String<ExtensionEndPosition<TPos> > possibleEndsRight{};
+    // best ends of the recomputed part of an extension, see _recomputeExtensionTrace
+    String<ExtensionEndPosition<TPos> > recomputedEnds{};
+    LongestEpsMatchScratch<TPos> longestEpsMatch{};
+
+    // score, alignment length and best end buffers of _align_banded_nw_best_ends
+    AlignBandedNwBestEndsBuffers<int> bandedNwBestEnds{};
+
+    // sequences left of the eps-core, the left extension reads them through reverse views
+    TInfix infixLeftH{};
+    TInfix infixLeftV{};
+    StringSet<TReverseInfix> sequencesLeft{};
+    StringSet<TInfix> sequencesRight{};
+
+    // traceback of an extension
+    AlignTraceback<TPos> traceBack{};
+    Align<TInfix> infixAlign{};
+
+    // gaps of longestEpsMatch(align, ...)
+    String<Triple<TPos, TPos, TPos> > epsMatchGaps{};
+};
+
+} // namespace stellar
@@ -0,0 +1,222 @@
+
+#pragma once
+
+#include <cstdint>
+#include <iterator>
+
+#include <seqan/sequence.h>
+#include <seqan/align/align_traceback.h> // needs seqan/sequence.h
+
+namespace stellar
+{
+
+///////////////////////////////////////////////////////////////////////////////
+// Trace values (Diagonal = 0, Horizontal = 1, Vertical = 2) of a banded extension matrix, packed with 2 bits per
+// cell into 64 bit words. Uses a quarter of the memory of a seqan::String<seqan::TraceBack>.
+struct extension_packed_trace
+{
+    static constexpr size_t bits_per_value = 2u;
+    static constexpr size_t values_per_word = 64u / bits_per_value;
+
+    // the values of the cells are undefined until they are set
+    void resize(size_t const size)
+    {
+        _size = size;
+        seqan::resize(_words, (size + values_per_word - 1) / values_per_word, uint64_t{0u});
+    }
+
+    size_t size() const
+    {
+        return _size;
+    }
+
+    // bytes of the packed values
+    size_t byteSize() const
+    {
+        return seqan::length(_words) * sizeof(uint64_t);
+    }
+
+    seqan::TraceBack get(size_t const position) const
+    {
+        return (_words[position / values_per_word] >> _shift(position)) & _value_mask;
+    }
+
+    void set(size_t const position, seqan::TraceBack const value)
+    {
+        uint64_t & word = _words[position / values_per_word];
+        word = (word & ~(_value_mask << _shift(position))) | ((uint64_t{value} & _value_mask) << _shift(position));
+    }
+
+private:
+    static constexpr uint64_t _value_mask = (uint64_t{1u} << bits_per_value) - 1u;
+
+    static size_t _shift(size_t const position)
+    {
+        return (position % values_per_word) * bits_per_value;
+    }
+
+    seqan::String<uint64_t> _words{};
+    size_t _size{0u};
+};
+
+///////////////////////////////////////////////////////////////////////////////
+// Read-only view of consecutive cells of an extension_packed_trace, the packed counterpart of
+// std::span<seqan::TraceBack>.
+struct extension_packed_trace_span
+{
+    struct iterator
+    {
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = seqan::TraceBack;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = seqan::TraceBack;
+
+        seqan::TraceBack operator*() const { return _trace->get(_position); }
+        seqan::TraceBack operator[](difference_type const offset) const { return _trace->get(_position + offset); }
+        iterator & operator++() { ++_position; return *this; }
+        iterator operator++(int) { iterator it = *this; ++_position; return it; }
+        iterator & operator--() { --_position; return *this; }
+        iterator operator--(int) { iterator it = *this; --_position; return it; }
+        iterator & operator+=(difference_type const offset) { _position += offset; return *this; }
+        iterator & operator-=(difference_type const offset) { _position -= offset; return *this; }
+        friend iterator operator+(iterator it, difference_type const offset) { return it += offset; }
+        friend iterator operator+(difference_type const offset, iterator it) { return it += offset; }
+        friend iterator operator-(iterator it, difference_type const offset) { return it -= offset; }
+        friend difference_type operator-(iterator const & it1, iterator const & it2)
+        {
+            return (difference_type)it1._position - (difference_type)it2._position;
+        }
+        friend bool operator==(iterator const & it1, iterator const & it2) { return it1._position == it2._position; }
+        friend auto operator<=>(iterator const & it1, iterator const & it2) { return it1._position <=> it2._position; }
+
+        extension_packed_trace const * _trace{nullptr};
+        size_t _position{0u};
+    };
+
+    iterator begin() const
+    {
+        return {_trace, _offset};
+    }
+
+    iterator end() const
+    {
+        return {_trace, _offset + _size};
+    }
+
+    size_t size() const
+    {
+        return _size;
+    }
+
+    bool empty() const
+    {
+        return _size == 0u;
+    }
+
+    seqan::TraceBack operator[](size_t const position) const
+    {
+        return _trace->get(_offset + position);
+    }
+
+    extension_packed_trace_span subspan(size_t const offset, size_t const count) const
+    {
+        return {_trace, _offset + offset, count};
+    }
+
+    extension_packed_trace const * _trace{nullptr};
+    size_t _offset{0u};
+    size_t _size{0u};
+};
+
+///////////////////////////////////////////////////////////////////////////////
+// A trace matrix that discards all trace values. _align_banded_nw_best_ends computes only the best ends with it, in
+// memory linear in the band width.
+struct extension_score_only_trace
+{};
+
+///////////////////////////////////////////////////////////////////////////////
+// Access to the cells of a trace matrix, either a seqan::String<seqan::TraceBack> (or any other random access
+// container), an extension_packed_trace or an extension_score_only_trace.
+template <typename TTrace, typename TSize>
+inline void
+_resizeTrace(TTrace & trace, TSize const size)
+{
+    resize(trace, size);
+}
+
+template <typename TSize>
+inline void
+_resizeTrace(extension_packed_trace & trace, TSize const size)
+{
+    trace.resize(size);
+}
+
+template <typename TSize>
+inline void
+_resizeTrace(extension_score_only_trace &, TSize const)
+{}
+
+template <typename TTrace, typename TPosition, typename TValue>
+inline void
+_assignTraceValue(TTrace & trace, TPosition const position, TValue const value)
+{
+    trace[position] = value;
+}
+
+template <typename TPosition, typename TValue>
+inline void
+_assignTraceValue(extension_packed_trace & trace, TPosition const position, TValue const value)
+{
+    trace.set(position, value);
+}
+
+template <typename TPosition, typename TValue>
+inline void
+_assignTraceValue(extension_score_only_trace &, TPosition const, TValue const)
+{}
+
+template <typename TTrace, typename TPosition>
+inline auto
+_getTraceValue(TTrace const & trace, TPosition const position)
+{
+    return trace[position];
+}
+
+template <typename TPosition>
+inline seqan::TraceBack
+_getTraceValue(extension_packed_trace const & trace, TPosition const position)
+{
+    return trace.get(position);
+}
+
+} // namespace stellar
+
+namespace seqan
+{
+
+template <>
+struct Value<stellar::extension_packed_trace>
+{
+    using Type = TraceBack;
+};
+
+template <>
+struct Size<stellar::extension_packed_trace>
+{
+    using Type = size_t;
+};
+
+template <>
+struct Value<stellar::extension_score_only_trace>
+{
+    using Type = TraceBack;
+};
+
+template <>
+struct Size<stellar::extension_score_only_trace>
+{
+    using Type = size_t;
+};
+
+} // namespace seqan
@@ -1,6 +1,8 @@
 
 #pragma once
 
+#include <algorithm>
+
 #include <seqan/seeds.h>
 
 #include <stellar/extension/extension_end_position.hpp>
@@ -9,9 +11,33 @@ namespace stellar
 {
 using namespace seqan;
 
+///////////////////////////////////////////////////////////////////////////////
+// Minima over the right end candidates of longestEpsMatch, they keep their capacity between calls.
+template <typename TLength>
+struct LongestEpsMatchScratch
+{
+    String<TLength> rightMinLengths{}; // min. length of the right ends j, j+1, ...
+    // level k: min. j - maxErrorRate * length of the right ends j, ..., j + 2^k - 1 (a sparse table)
+    String<double> errorBalanceMinima{};
+};
+
 ///////////////////////////////////////////////////////////////////////////////
 // Identifies the longest epsilon match in align from possEndsLeft and possEndsRight and sets the view positions of
 // align to start and end position of the longest epsilon match
+//
+// possEndsLeft[i] (possEndsRight[j]) is the longest left (right) extension with i (j) errors. The left ends are
+// visited by decreasing i; for each, the right ends are visited by decreasing j, as long as the total length is at
+// least the length of the best match so far, and the first right end that gives an eps-match is taken. Instead of
+// testing all right ends,
+//   * the suffix minima of the lengths of the right ends give the smallest j that is still long enough by binary
+//     search, and
+//   * the minima of the error balances of blocks of 2^k right ends give the largest j that can satisfy
+//     (i + alignErr + j) < maxErrorRate * (length_i + alignLen + length_j), i.e.
+//     j - maxErrorRate * length_j < maxErrorRate * (length_i + alignLen) - i - alignErr,
+//     by skipping the blocks from the last right end on whose minimum is too large, one block per k.
+// The j is confirmed with the exact error rate test, such that the result is the same pair as of testing all
+// combinations. Only a j within the rounding slack of the first test can fail the exact test and lead to the next
+// search, so the pair is found in O((|possEndsLeft| + |possEndsRight|) * log |possEndsRight|).
 template<typename TLength, typename TSize, typename TEps>
 Pair<typename Iterator<String<ExtensionEndPosition<TLength> > const>::Type>
 longestEpsMatch(String<ExtensionEndPosition<TLength> > const & possEndsLeft,
@@ -19,51 +45,97 @@ longestEpsMatch(String<ExtensionEndPosition<TLength> > const & possEndsLeft,
                 TLength const alignLen,
                 TLength const alignErr,
                 TSize const matchMinLength,
-                TEps const epsilon) {
+                TEps const epsilon,
+                LongestEpsMatchScratch<TLength> & scratch) {
     typedef ExtensionEndPosition<TLength>               TEnd;
     typedef typename Iterator<String<TEnd> const>::Type TIterator;
 
-    // Identify longest eps match by iterating over combinations of left and right positions
-    TIterator rightIt = end(possEndsRight) - 1;
-    TIterator leftIt = end(possEndsLeft) - 1;
-    TIterator right = begin(possEndsRight);
-    TIterator left = begin(possEndsLeft);
+    SEQAN_ASSERT_NOT(empty(possEndsLeft));
+    SEQAN_ASSERT_NOT(empty(possEndsRight));
+
+    // DELTA is used below against floating point rounding errors.
+    double const DELTA = 0.000001;
+    double const maxErrorRate = epsilon + DELTA;
+
+    auto errorBalance = [&](TSize const rightErr) -> double
+    {
+        return (double)rightErr - maxErrorRate * (double)possEndsRight[rightErr].length;
+    };
+
+    TSize const rightCount = length(possEndsRight);
+    String<TLength> & rightMinLengths = scratch.rightMinLengths;
+    resize(rightMinLengths, rightCount);
+    TLength maxRightLength = 0;
+    for (TSize rightErr = rightCount; rightErr-- > 0;) {
+        maxRightLength = std::max(maxRightLength, possEndsRight[rightErr].length);
+        rightMinLengths[rightErr] = possEndsRight[rightErr].length;
+        if (rightErr + 1 < rightCount)
+            rightMinLengths[rightErr] = std::min(rightMinLengths[rightErr], rightMinLengths[rightErr + 1]);
+    }
 
-    /*for (int i = 0; i < length(possEndsRight); ++i) {
-        std::cout << possEndsRight[i].length << "  " << possEndsRight[i].coord.i1 << "," << possEndsRight[i].coord.i2 << std::endl;
+    // errorBalanceMinima[level * rightCount + j] is the min. error balance of the right ends j, ..., j + 2^level - 1
+    TSize levelCount = 1;
+    while (((TSize)1 << levelCount) <= rightCount)
+        ++levelCount;
+    String<double> & errorBalanceMinima = scratch.errorBalanceMinima;
+    resize(errorBalanceMinima, levelCount * rightCount);
+    for (TSize rightErr = 0; rightErr < rightCount; ++rightErr)
+        errorBalanceMinima[rightErr] = errorBalance(rightErr);
+    for (TSize level = 1; level < levelCount; ++level) {
+        TSize const half = (TSize)1 << (level - 1);
+        double * const minima = begin(errorBalanceMinima, Standard()) + level * rightCount;
+        double const * const halfMinima = minima - rightCount;
+        for (TSize rightErr = 0; rightErr + 2 * half <= rightCount; ++rightErr)
+            minima[rightErr] = std::min(halfMinima[rightErr], halfMinima[rightErr + half]);
     }
-    for (int i = 0; i < length(possEndsLeft); ++i) {
-        std::cout << possEndsLeft[i].length << "  " << possEndsLeft[i].coord.i1 << "," << possEndsLeft[i].coord.i2 << std::endl;
-    }*/
 
-    TSize leftErr = length(possEndsLeft) - 1;
+    // returns one past the largest j in [rightBegin, rightEnd) with an error balance below maxBalance, or rightBegin
+    // if there is none
+    auto endOfLastBelow = [&](TSize const rightBegin, TSize rightEnd, double const maxBalance) -> TSize
+    {
+        for (TSize level = levelCount; level-- > 0;) {
+            TSize const blockLength = (TSize)1 << level;
+            if (rightEnd >= rightBegin + blockLength &&
+                !(errorBalanceMinima[level * rightCount + rightEnd - blockLength] < maxBalance))
+                rightEnd -= blockLength;
+        }
+        return rightEnd;
+    };
 
     TSize minLength = matchMinLength;
     bool found = false;
-    // DELTA is used below against floating point rounding errors.
-    double const DELTA = 0.000001;
+    TIterator right = begin(possEndsRight);
+    TIterator left = begin(possEndsLeft);
+
+    for (TSize leftErr = length(possEndsLeft); leftErr-- > 0;) {
+        TSize const leftLen = possEndsLeft[leftErr].length + alignLen;
+        TSize const maxTotalLen = leftLen + possEndsRight[rightCount - 1].length;
+        if (maxTotalLen < minLength) break;
+
+        // right ends rightErr >= rightBegin are long enough
+        TSize rightBegin = 0;
+        if (leftLen < minLength)
+            rightBegin = std::lower_bound(begin(rightMinLengths, Standard()), end(rightMinLengths, Standard()),
+                                          (TLength)(minLength - leftLen)) - begin(rightMinLengths, Standard());
 
-    while (leftIt >= begin(possEndsLeft)) {
-        TSize totalLen = (*leftIt).length + alignLen + (*rightIt).length;
-        if (totalLen < minLength) break;
-        TSize totalErr = leftErr + alignErr + length(possEndsRight) - 1;
-        while (rightIt >= begin(possEndsRight)) {
-            totalLen = (*leftIt).length + alignLen + (*rightIt).length;
-            if (totalLen < minLength) break;
+        // right ends with an error balance below maxBalance may give an eps-match; the slack bounds the rounding
+        // errors (also of the error rate test in TEps), candidates are confirmed with the exact test
+        double const balanceSlack = 0.000001 * (1.0 + (double)leftLen + (double)maxRightLength);
+        double const maxBalance = maxErrorRate * (double)leftLen - (double)(leftErr + alignErr) + balanceSlack;
+
+        for (TSize rightEnd = endOfLastBelow(rightBegin, rightCount, maxBalance); rightEnd > rightBegin;
+             rightEnd = endOfLastBelow(rightBegin, rightEnd - 1, maxBalance)) {
+            TSize const rightErr = rightEnd - 1;
+            TSize const totalLen = leftLen + possEndsRight[rightErr].length;
+            TSize const totalErr = leftErr + alignErr + rightErr;
             if ((TEps)totalErr/(TEps)totalLen < epsilon + DELTA) {
-                right = rightIt;
-                left = leftIt;
-                //std::cout << totalLen << std::endl;
+                right = begin(possEndsRight) + rightErr;
+                left = begin(possEndsLeft) + leftErr;
                 minLength = totalLen;
                 found = true;
                 break;
             }
-            --rightIt;
-            --totalErr;
         }
-        rightIt = end(possEndsRight) - 1;
-        --leftIt;
-        --leftErr;
     }
 
     if (found)
@@ -72,4 +144,16 @@ longestEpsMatch(String<ExtensionEndPosition<TLength> > const & possEndsLeft,
         return Pair<TIterator>(0,0);
 }
 
+template<typename TLength, typename TSize, typename TEps>
+Pair<typename Iterator<String<ExtensionEndPosition<TLength> > const>::Type>
+longestEpsMatch(String<ExtensionEndPosition<TLength> > const & possEndsLeft,
+                String<ExtensionEndPosition<TLength> > const & possEndsRight,
+                TLength const alignLen,
+                TLength const alignErr,
+                TSize const matchMinLength,
+                TEps const epsilon) {
+    LongestEpsMatchScratch<TLength> scratch{};
+    return longestEpsMatch(possEndsLeft, possEndsRight, alignLen, alignErr, matchMinLength, epsilon, scratch);
+}
+
 } // namespace stellar
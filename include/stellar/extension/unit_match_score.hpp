@@ -0,0 +1,100 @@
+
+#pragma once
+
+#include <seqan/score.h>
+
+namespace stellar
+{
+
+///////////////////////////////////////////////////////////////////////////////
+// Scoring scheme of eps-matches: a match scores 1, a mismatch and a gap score the same penalty. The match score is
+// a compile-time constant, such that the DP kernels don't need to look up scores of character pairs.
+template <typename TScoreValue>
+struct UnitMatchScore
+{
+    static constexpr TScoreValue match = 1;
+
+    TScoreValue penalty;
+};
+
+template <typename TScoreValue>
+constexpr TScoreValue
+scoreMatch(UnitMatchScore<TScoreValue> const &)
+{
+    return UnitMatchScore<TScoreValue>::match;
+}
+
+template <typename TScoreValue>
+constexpr TScoreValue
+scoreMismatch(UnitMatchScore<TScoreValue> const & sc)
+{
+    return sc.penalty;
+}
+
+template <typename TScoreValue>
+constexpr TScoreValue
+scoreGap(UnitMatchScore<TScoreValue> const & sc)
+{
+    return sc.penalty;
+}
+
+template <typename TScoreValue, typename TAlphabet>
+constexpr TScoreValue
+scoreGapExtendHorizontal(UnitMatchScore<TScoreValue> const & sc, TAlphabet const &, TAlphabet const &)
+{
+    return sc.penalty;
+}
+
+template <typename TScoreValue, typename TAlphabet>
+constexpr TScoreValue
+scoreGapExtendVertical(UnitMatchScore<TScoreValue> const & sc, TAlphabet const &, TAlphabet const &)
+{
+    return sc.penalty;
+}
+
+template <typename TScoreValue, typename TAlphabet>
+constexpr TScoreValue
+score(UnitMatchScore<TScoreValue> const & sc, TAlphabet const & a, TAlphabet const & b)
+{
+    return (a == b) ? UnitMatchScore<TScoreValue>::match : sc.penalty;
+}
+
+// the characters are compared directly, there is no score matrix to index
+template <typename TScoreValue, typename TSequence, typename TPosition>
+inline auto
+sequenceEntryForScore(UnitMatchScore<TScoreValue> const &, TSequence const & sequence, TPosition const position)
+{
+    return sequence[position];
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Returns the UnitMatchScore of an eps-match scoring scheme Score<TScoreValue>(1, penalty, penalty).
+template <typename TScoreValue>
+inline UnitMatchScore<TScoreValue>
+_unitMatchScore(seqan::Score<TScoreValue, seqan::Simple> const & sc)
+{
+    SEQAN_ASSERT_EQ(scoreMatch(sc), TScoreValue{1});
+    SEQAN_ASSERT_EQ(scoreMismatch(sc), scoreGap(sc));
+    SEQAN_ASSERT_EQ(scoreGapOpen(sc), scoreGapExtend(sc));
+    return UnitMatchScore<TScoreValue>{scoreGap(sc)};
+}
+
+template <typename TScoreValue>
+inline UnitMatchScore<TScoreValue>
+_unitMatchScore(UnitMatchScore<TScoreValue> const & sc)
+{
+    return sc;
+}
+
+} // namespace stellar
+
+namespace seqan
+{
+
+template <typename TScoreValue>
+struct Value<stellar::UnitMatchScore<TScoreValue>>
+{
+    using Type = TScoreValue;
+};
+
+} // namespace seqan
@@ -10,6 +10,7 @@ struct IndexOptions
 {
     unsigned qGram{std::numeric_limits<unsigned>::max()}; // length of the q-grams
     double qgramAbundanceCut{1};
+    bool autoTuneQGram{false}; // choose qGram by sampling the filter and verification cost on the database
 };
 
 } // namespace stellar
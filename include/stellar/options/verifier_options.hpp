@@ -53,6 +53,7 @@ private:
 struct VerifierOptions
 {
     double xDrop{5}; // maximal x-drop
+    bool precheck{false}; // skip swift hits that provably contain no eps-match (bit-parallel edit distance bound)
 
     // verification strategy: exact, bestLocal, bandedGlobal
     StellarVerificationMethod verificationMethod{AllLocal{}};
@@ -24,7 +24,19 @@
 #ifndef SEQAN_HEADER_STELLAR_H
 #define SEQAN_HEADER_STELLAR_H
 
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <functional>
 #include <iostream>
+#include <iterator>
+#include <set>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
 #include <seqan/seeds.h>
 
 #include <stellar/stellar_types.hpp>
@@ -32,13 +44,17 @@
 #include <stellar/stellar_database_segment.hpp>
 #include <stellar/stellar_query_segment.hpp>
 #include <stellar/stellar_query_segment.tpp>
+#include <stellar/stellar_swift_hit.hpp>
 #include <stellar/stellar_index.hpp>
 #include <stellar/utils/stellar_kernel_runtime.hpp>
 #include <stellar/verification/all_local.hpp>
 #include <stellar/verification/banded_global_extend.hpp>
 #include <stellar/verification/banded_global.hpp>
 #include <stellar/verification/best_local.hpp>
+#include <stellar/verification/detail/banded_local_max_score.hpp>
+#include <stellar/verification/swift_hit_precheck.hpp>
 #include <stellar/verification/swift_hit_verifier.hpp>
+#include <stellar/verification/verification_context.hpp>
 
 #include <stellar/app/stellar.diagnostics.hpp>
 
@@ -55,10 +71,11 @@ using namespace seqan;
 //  whether the non-overlaping parts are shorter than minLength.
 template<typename TMatch, typename TSize>
 bool
-checkOverlap(TMatch const & matchA, TMatch const & matchB, TSize const minLength) {
+checkOverlap(TMatch const & matchA, TMatch const & matchB, String<StellarEditRun> const & editScripts,
+             TSize const minLength) {
     // check id and orienation
-    if (matchA.id != matchB.id || matchA.orientation != matchB.orientation) return false;
-    if (matchA.id == TMatch::INVALID_ID || matchB.id == TMatch::INVALID_ID) return false;
+    if (matchA.databaseRecordID != matchB.databaseRecordID || matchA.orientation != matchB.orientation) return false;
+    if (!matchA.valid || !matchB.valid) return false;
 
     // check overlap in seq2
     if (matchA.begin2 >= matchB.begin2) {
@@ -70,8 +87,8 @@ checkOverlap(TMatch const & matchA, TMatch const & matchB, TSize const minLength
             }
         }
         // check whether offset is the same in both sequences
-        if (toViewPosition(matchA.row2, matchA.begin2) - toViewPosition(matchB.row2, matchB.begin2) !=
-            toViewPosition(matchA.row1, matchA.begin1) - toViewPosition(matchB.row1, matchB.begin1)) {
+        if (_viewBeginPosition(matchA, editScripts, 1) - _viewBeginPosition(matchB, editScripts, 1) !=
+            _viewBeginPosition(matchA, editScripts, 0) - _viewBeginPosition(matchB, editScripts, 0)) {
             return false;
         }
     } else {
@@ -83,106 +100,209 @@ checkOverlap(TMatch const & matchA, TMatch const & matchB, TSize const minLength
             }
         }
         // check whether offset is the same in both sequences
-        if (toViewPosition(matchB.row2, matchB.begin2) - toViewPosition(matchA.row2, matchA.begin2) !=
-            toViewPosition(matchB.row1, matchB.begin1) - toViewPosition(matchA.row1, matchA.begin1)) {
+        if (_viewBeginPosition(matchB, editScripts, 1) - _viewBeginPosition(matchA, editScripts, 1) !=
+            _viewBeginPosition(matchB, editScripts, 0) - _viewBeginPosition(matchA, editScripts, 0)) {
             return false;
         }
     }
     return true;
 }
 
-template<typename TRow, typename TPosition>
-TPosition
-projectedPosition(TRow const & rowA, TRow const & rowB, TPosition pos)
+///////////////////////////////////////////////////////////////////////////////
+// Walks the database positions of a match in segments, in which the query position of the alignment column of a
+//   database position (the next query position if the column has a gap in the query) is either increasing by one
+//   (aligned run) or constant (deletion run).
+template<typename TMatch>
+struct ProjectedSegments
 {
-    return toSourcePosition(rowB, toViewPosition(rowA, pos));
+    struct Segment
+    {
+        int64_t databaseBegin;
+        int64_t databaseEnd;
+        int64_t queryBegin; // query position of the column of databaseBegin
+        bool aligned;
+
+        int64_t projectedPosition(int64_t const pos) const
+        {
+            return aligned ? queryBegin + (pos - databaseBegin) : queryBegin;
+        }
+    };
+
+    ProjectedSegments(TMatch const & match, String<StellarEditRun> const & editScripts) :
+        editScript{_editScript(match, editScripts)}, databaseEnd{(int64_t)match.begin1}, queryEnd{(int64_t)match.begin2}
+    {}
+
+    // moves to the next segment, returns false if there is none
+    bool next()
+    {
+        for (; run < editScript.size(); ++run)
+        {
+            StellarEditRun const editRun = editScript[run];
+            if (editRun.kind == StellarEditRun::insertion)
+            {
+                queryEnd += editRun.count;
+                continue;
+            }
+
+            bool const aligned = editRun.kind == StellarEditRun::aligned;
+            segment = Segment{databaseEnd, databaseEnd + editRun.count, queryEnd, aligned};
+            databaseEnd += editRun.count;
+            if (aligned)
+                queryEnd += editRun.count;
+            ++run;
+            return true;
+        }
+        return false;
+    }
+
+    std::span<StellarEditRun const> editScript;
+    size_t run{0u};
+    int64_t databaseEnd;
+    int64_t queryEnd;
+    Segment segment{};
+};
+
+///////////////////////////////////////////////////////////////////////////////
+// Counts the database positions in [begin, end) that are projected onto the same query position by both segments.
+template<typename TSegment>
+inline int64_t
+_equalProjectedColumns(TSegment const & segmentA, TSegment const & segmentB, int64_t const begin, int64_t const end)
+{
+    if (segmentA.aligned == segmentB.aligned)
+        return (segmentA.projectedPosition(begin) == segmentB.projectedPosition(begin)) ? end - begin : 0;
+
+    // one projection increases by one per position, the other one is constant: they meet at most once
+    TSegment const & alignedSegment = segmentA.aligned ? segmentA : segmentB;
+    TSegment const & gapSegment = segmentA.aligned ? segmentB : segmentA;
+    int64_t const pos = alignedSegment.databaseBegin + (gapSegment.queryBegin - alignedSegment.queryBegin);
+    return (begin <= pos && pos < end) ? 1 : 0;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
 // Checks all alignment columns of two overlapping matches.
 // It is assumed that matchA.begin1 < matchB.begin1.
+// The edit scripts of both matches are merged segment by segment, each pair of segments is compared in constant time.
 template<typename TMatch, typename TSize>
 bool
-_checkAlignColOverlap(TMatch const & matchA, TMatch const & matchB, TSize const minLength)
+_checkAlignColOverlap(TMatch const & matchA, TMatch const & matchB, String<StellarEditRun> const & editScripts,
+                      TSize const minLength)
 {
-    TSize equalCols = 0;
-    TSize diffCols = 0;
+    int64_t const overlapBegin = matchB.begin1;
+    int64_t const overlapEnd = _min(matchA.end1, matchB.end1);
+    int64_t diffCols = 0;
+
+    ProjectedSegments<TMatch> segmentsA{matchA, editScripts};
+    ProjectedSegments<TMatch> segmentsB{matchB, editScripts};
+    bool hasSegmentA = segmentsA.next();
+    bool hasSegmentB = segmentsB.next();
 
-    for  (typename TMatch::TPos pos = matchB.begin1; pos < _min(matchA.end1, matchB.end1); ++pos)
+    while (hasSegmentA && hasSegmentB)
     {
-        if (projectedPosition(matchA.row1, matchA.row2, pos) == projectedPosition(matchB.row1, matchB.row2, pos))
-            ++equalCols;
+        auto const & segmentA = segmentsA.segment;
+        auto const & segmentB = segmentsB.segment;
+
+        int64_t const begin = std::max({overlapBegin, segmentA.databaseBegin, segmentB.databaseBegin});
+        int64_t const end = std::min({overlapEnd, segmentA.databaseEnd, segmentB.databaseEnd});
+        if (begin < end)
+        {
+            diffCols += (end - begin) - _equalProjectedColumns(segmentA, segmentB, begin, end);
+            if (diffCols >= (int64_t)minLength) return false;
+        }
+
+        if (end >= overlapEnd)
+            break;
+
+        if (segmentA.databaseEnd <= segmentB.databaseEnd)
+            hasSegmentA = segmentsA.next();
         else
-            ++diffCols;
+            hasSegmentB = segmentsB.next();
     }
 
-    if (diffCols >= minLength) return false;
+    if (diffCols >= (int64_t)minLength) return false;
     return true;
 }
 
+///////////////////////////////////////////////////////////////////////////////
+// Checks whether two matches overlap in both sequences, such that the shorter one is removed.
+// It is assumed that matchA.begin1 <= matchB.begin1.
+template<typename TMatch, typename TSize>
+inline bool
+_matchesOverlap(TMatch const & matchA, TMatch const & matchB, String<StellarEditRun> const & editScripts,
+                TSize const minLength)
+{
+    typedef typename TMatch::TPos TPos;
+
+    // check if matches overlap in row0
+    if (matchA.end1 <= matchB.begin1) return false;
+
+    // check if unique parts of the two matches in row0 are longer than minLength
+    if (matchB.begin1 - matchA.begin1 >= (TPos)minLength &&
+        matchB.end1 > matchA.end1 && matchB.end1 - matchA.end1 >= (TPos)minLength) return false;
+
+    // check if matches overlap in row1 and check exact alignment columns for overlap
+    return checkOverlap(matchB, matchA, editScripts, minLength) &&
+           _checkAlignColOverlap(matchA, matchB, editScripts, minLength);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // Marks matches that overlap in both sequences with a longer match as invalid.
+// Sweeps over the matches sorted by begin position in row0 and keeps the matches that still overlap the sweep
+//   position in a balanced search tree.
 template<typename TSequence, typename TId, typename TSize>
-void maskOverlaps(String<StellarMatch<TSequence const, TId> > & matches, TSize const minLength)
+void maskOverlaps(String<StellarMatch<TSequence const, TId> > & matches,
+                  String<StellarEditRun> const & editScripts,
+                  TSize const minLength)
 {
     typedef StellarMatch<TSequence const, TId>              TMatch;
     typedef typename TMatch::TPos                           TPos;
-    typedef typename Iterator<String<TMatch>, Rooted>::Type TIter;
-    typedef typename Iterator<String<TSize>, Rooted>::Type  TOverlapIter;
 
     // sort matches by begin position in row0
     sortMatches(matches, LessPos<TMatch>());
 
-    // iterate all matches
-    TIter it = begin(matches);
+    // valid matches of the current database that potentially overlap with the current match in row0 and start
+    // earlier (including matches that overlap but have a unique part of at least minLength) as (end position,
+    // index), sorted by descending end positions and among equal end positions by the most recent match first
+    std::set<std::pair<TPos, size_t>, std::greater<>> overlaps;
 
-    // list of matches that potentially overlap with the current match in row0 and
-    // start earlier (including matches that overlap but have a unique part of at
-    // least minLength) sorted by descending end positions
-    String<TSize> overlaps;
-
-    for (; it != end(matches); ++it)
+    for (size_t i = 0; i < length(matches); ++i)
     {
-        if ((*it).id == TMatch::INVALID_ID) continue;
-
-        TPos insertPos = 0;
-
-        // iterate potentially overlapping matches
-        TOverlapIter overlapIt = begin(overlaps);
-        for (; overlapIt != end(overlaps); ++overlapIt)
-        {
-            TMatch & o = matches[*overlapIt];
-
-            // determine position for inserting *it into overlaps after checking
-            if ((*it).end1 < o.end1) insertPos++;
+        TMatch & match = matches[i];
+        if (i > 0 && matches[i - 1].databaseRecordID != match.databaseRecordID)
+            overlaps.clear();
 
-            // check if matches overlap in row0 - if not, then break
-            if (o.end1 <= (*it).begin1) break;
+        if (!match.valid) continue;
 
-            // check if unique parts of the two matches in row0 are longer than minLength - if yes, then continue
-            if ((*it).begin1 - o.begin1 >= (TPos)minLength &&
-                (*it).end1 > o.end1 && (*it).end1 - o.end1 >= (TPos)minLength) continue;
+        // remove all matches from overlaps that end earlier than current match begins
+        while (!overlaps.empty() && std::prev(overlaps.end())->first <= match.begin1)
+            overlaps.erase(std::prev(overlaps.end()));
 
-            // check if matches overlap in row1 - if not, then continue
-            if (!checkOverlap(*it, o, minLength)) continue;
+        // iterate overlapping matches
+        for (auto overlapIt = overlaps.begin(); overlapIt != overlaps.end();)
+        {
+            TMatch & o = matches[overlapIt->second];
 
-            // check exact alignment columns for overlap
-            if (!_checkAlignColOverlap(o, *it, minLength)) continue;
+            if (!_matchesOverlap(o, match, editScripts, minLength))
+            {
+                ++overlapIt;
+                continue;
+            }
 
             // set shorter match invalid
-            if (length(*it) > length(o))
-                o.id = TMatch::INVALID_ID;
+            if (length(match) > length(o))
+            {
+                o.valid = false;
+                overlapIt = overlaps.erase(overlapIt);
+            }
             else
-                (*it).id = TMatch::INVALID_ID;
+            {
+                match.valid = false;
+                break;
+            }
         }
 
-        // remove all matches from overlaps that end earlier than current match begins
-        resize(overlaps, position(overlapIt));
-
-        if ((*it).id != TMatch::INVALID_ID)
-            insertValue(overlaps, insertPos, position(it));
+        if (match.valid)
+            overlaps.emplace(match.end1, i);
     }
-
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -203,7 +323,7 @@ compactMatches(String<StellarMatch<TSequence const, TId> > & matches, TSize cons
     TIterator itEnd = end(matches, Standard());
 
     for(; it != itEnd; ++it) {
-        if ((*it).id != TMatch::INVALID_ID)
+        if ((*it).valid)
             ++num;
     }
 
@@ -227,53 +347,270 @@ removeOverlapsAndCompactMatches(size_t const disableThresh,
     if (matchesCount > disableThresh) {
         this->disabled = true;
         clear(this->matches);
+        clear(this->editScripts);
         return false;
     }
 
     if (matchesCount <= compactThresh)
         return false;
 
-    maskOverlaps(this->matches, minLength);      // remove overlaps and duplicates
-    compactMatches(this->matches, numMatches);   // keep only the <numMatches> longest matches
+    maskOverlaps(this->matches, this->editScripts, minLength);  // remove overlaps and duplicates
+    compactMatches(this->matches, numMatches);                  // keep only the <numMatches> longest matches
+    _compactEditScripts(this->matches, this->editScripts);
+    _rebuildMatchIndex();
     return true;
 }
 
+template<typename TMatch_>
+inline void
+QueryMatches<TMatch_>::
+_indexMatch(size_t const index)
+{
+    TMatch_ const & match = this->matches[index];
+    this->matchesByBegin.emplace(match.databaseRecordID, match.begin1, index);
+    this->matchesByLength.emplace(match.end1 - match.begin1, index);
+    this->maxMatchSpan = _max(this->maxMatchSpan, match.end1 - match.begin1);
+}
+
+// marks the match as invalid
+template<typename TMatch_>
+inline void
+QueryMatches<TMatch_>::
+_unindexMatch(size_t const index)
+{
+    TMatch_ & match = this->matches[index];
+    this->matchesByBegin.erase({match.databaseRecordID, match.begin1, index});
+    this->matchesByLength.erase({match.end1 - match.begin1, index});
+    match.valid = false;
+}
+
+template<typename TMatch_>
+inline void
+QueryMatches<TMatch_>::
+_rebuildMatchIndex()
+{
+    this->matchesByBegin.clear();
+    this->matchesByLength.clear();
+    this->maxMatchSpan = 0;
+    for (size_t index = 0; index < length(this->matches); ++index)
+        if (this->matches[index].valid)
+            _indexMatch(index);
+}
+
+// removes the invalid matches and their edit scripts
+template<typename TMatch_>
+inline void
+QueryMatches<TMatch_>::
+_compactMatchStorage()
+{
+    size_t numValid = 0;
+    for (size_t index = 0; index < length(this->matches); ++index)
+        if (this->matches[index].valid)
+            this->matches[numValid++] = this->matches[index];
+    resize(this->matches, numValid);
+
+    _compactEditScripts(this->matches, this->editScripts);
+    _rebuildMatchIndex();
+}
+
 ///////////////////////////////////////////////////////////////////////////////
-// Appends a match to matches container and removes overlapping matches if threshold is reached.
-template<typename TSource, typename TId, typename TSize, typename TSize1>
+// Inserts the match of an alignment into the matches container, unless it overlaps with a longer or equally long
+//   match. Kept matches that overlap with the new match are removed. Only once more than compactThresh matches are
+//   kept, the shortest ones are removed down to numMatches, like the former periodic removeOverlapsAndCompactMatches
+//   did; until then a shorter match can still be output if a longer match replaces several kept matches. Removed
+//   matches are compacted when there are more than compactThresh of them and more than there are kept matches.
+// The query is disabled once more than disableThresh matches are stored.
+template<typename TSource, typename TId, typename TAlign, typename TSize, typename TSize1>
 inline bool
 _insertMatch(QueryMatches<StellarMatch<TSource const, TId> > & queryMatches,
-             StellarMatch<TSource const, TId> const & match,
+             TAlign const & alignment,
+             uint32_t const databaseRecordID,
+             bool const databaseStrand,
              TSize const minLength,
              TSize1 const disableThresh,
-             TSize1 & compactThresh,
+             TSize1 const compactThresh,
              TSize1 const numMatches) {
+    typedef StellarMatch<TSource const, TId> TMatch;
+    typedef typename TMatch::TPos TPos;
 
-    appendValue(queryMatches.matches, match);
+    if (queryMatches.disabled)
+        return true;
 
-    // std::cerr << "Inserting match \n-------------\n" << match.row1 <<"\n" << match.row2 << "----------------\n";
+    size_t const editScriptsLength = length(queryMatches.editScripts);
+    TMatch match(alignment, databaseRecordID, databaseStrand, queryMatches.editScripts);
 
-    if (queryMatches.removeOverlapsAndCompactMatches(disableThresh, compactThresh, minLength, numMatches))
+    // kept matches that overlap with the match begin at most maxMatchSpan positions before it
+    TPos const searchBegin = (match.begin1 > queryMatches.maxMatchSpan) ? match.begin1 - queryMatches.maxMatchSpan : 0;
+    auto overlapIt = queryMatches.matchesByBegin.lower_bound({databaseRecordID, searchBegin, 0u});
+    auto const overlapEnd = queryMatches.matchesByBegin.lower_bound({databaseRecordID, match.end1, 0u});
+
+    std::vector<size_t> overlappedMatches{};
+    for (; overlapIt != overlapEnd; ++overlapIt)
+    {
+        size_t const index = std::get<2>(*overlapIt);
+        TMatch const & o = queryMatches.matches[index];
+
+        bool const overlap = (o.begin1 <= match.begin1) ? _matchesOverlap(o, match, queryMatches.editScripts, minLength)
+                                                        : _matchesOverlap(match, o, queryMatches.editScripts, minLength);
+        if (!overlap)
+            continue;
+
+        // reject the shorter match
+        if (length(o) >= length(match))
+        {
+            resize(queryMatches.editScripts, editScriptsLength);
+            return true;
+        }
+        overlappedMatches.push_back(index);
+    }
+
+    for (size_t const index : overlappedMatches)
+        queryMatches._unindexMatch(index);
+
+    // counted only for stored matches, such that the identity and the E-value of the output don't walk the
+    // alignment again
+    match.matchingColumns = _countMatchingColumns(match, queryMatches.editScripts);
+    appendValue(queryMatches.matches, match);
+
+    if (length(queryMatches.matches) > disableThresh)
     {
-        // raise compact threshold if many matches are kept
-        if ((length(queryMatches.matches) << 1) > compactThresh)
-            compactThresh += (compactThresh >> 1);
+        queryMatches.disabled = true;
+        clear(queryMatches.matches);
+        clear(queryMatches.editScripts);
+        queryMatches._rebuildMatchIndex();
+        return true;
     }
+
+    queryMatches._indexMatch(length(queryMatches.matches) - 1);
+
+    // keep only the <numMatches> longest matches
+    if (queryMatches.matchesByLength.size() > std::max<size_t>(compactThresh, numMatches))
+        while (queryMatches.matchesByLength.size() > numMatches)
+            queryMatches._unindexMatch(queryMatches.matchesByLength.begin()->second);
+
+    size_t const numKept = queryMatches.matchesByLength.size();
+    if (length(queryMatches.matches) - numKept > std::max<size_t>(compactThresh, numKept))
+        queryMatches._compactMatchStorage();
+
     return true;
 }
 
+// number of swift hits that _stellarKernel collects for the local verification methods before verifying them
+constexpr size_t _bandedLocalPendingSize = 16u * _bandedLocalBatchSize;
+
+///////////////////////////////////////////////////////////////////////////////
+// Verifies the swift hits in the given order.
+// The local verification methods (exact, bestLocal) only extend local alignments that reach minScore. For them the
+// maximal banded local score of all given swift hits is computed first, in SIMD batches of swift hits with similar
+// band widths, and swift hits that can't reach minScore are skipped.
+template<typename TAlphabet, typename TTag, typename TIsQueryDisabledFn, typename TOnAlignmentResultFn, typename TOnSwiftHitFn>
+void
+_verifySwiftHits(std::span<StellarSwiftHit<TAlphabet> const> const swiftHits,
+                 SwiftHitVerifier<TTag> & swiftVerifier,
+                 TIsQueryDisabledFn && isQueryDisabled,
+                 TOnAlignmentResultFn && onAlignmentResult,
+                 TOnSwiftHitFn && onSwiftHit,
+                 StellarComputeStatistics & statistics,
+                 stellar_kernel_runtime & stellar_kernel_runtime) {
+    constexpr bool localVerification = std::is_same_v<TTag, AllLocal> || std::is_same_v<TTag, BestLocal>;
+
+    double const eps = (double)swiftVerifier.eps_match_options.epsilon;
+    int const minScore = _allOrBestLocalMinScore(eps, swiftVerifier.eps_match_options.minLength);
+
+    // the buffers of the verification are reused for all swift hits that this thread verifies
+    thread_local StellarVerificationContext<String<TAlphabet>> verificationContext{};
+    std::vector<int> & maxScores = verificationContext.bandedLocalMaxScores;
+
+    if constexpr (localVerification)
+    {
+        stellar_kernel_runtime.verification_time.measure_time([&]()
+        {
+            stellar_kernel_runtime.verification_time.banded_local_score_time.measure_time([&]()
+            {
+                maxScores.resize(swiftHits.size());
+                _bandedLocalMaxScores(swiftHits, eps, std::span<int>{maxScores}, verificationContext.bandedLocalScore);
+            });
+        });
+    }
+
+    for (size_t hitID = 0; hitID < swiftHits.size(); ++hitID)
+    {
+        StellarDatabaseSegment<TAlphabet> const & databaseSegment = swiftHits[hitID].databaseSegment;
+        StellarQuerySegment<TAlphabet> const & querySegment = swiftHits[hitID].querySegment;
+
+        ++statistics.numSwiftHits;
+        statistics.totalLength += databaseSegment.size();
+        statistics.maxLength = std::max<size_t>(statistics.maxLength, databaseSegment.size());
+
+        if (isQueryDisabled(querySegment))
+        {
+            onSwiftHit(databaseSegment, querySegment, false, stellar_runtime::duration_t{});
+            continue;
+        }
+
+        ////Debug stuff:
+        //std::cout << beginPosition(finderInfix) << ",";
+        //std::cout << endPosition(finderInfix) << "  ";
+        //std::cout << beginPosition(patternSegment) << ",";
+        //std::cout << endPosition(patternSegment) << std::endl;
+
+        stellar_runtime::duration_t const verificationTimeBefore = stellar_kernel_runtime.verification_time._runtime;
+
+        // verification
+        bool rejectedByPrecheck = false;
+        bool const verified = stellar_kernel_runtime.verification_time.measure_time([&]()
+        {
+            if constexpr (localVerification)
+                if (maxScores[hitID] < minScore)
+                    return false;
+
+            if (!_precheckSwiftHit(databaseSegment, querySegment, swiftHits[hitID].delta, swiftVerifier.eps_match_options,
+                                   swiftVerifier.verifier_options, stellar_kernel_runtime.verification_time))
+            {
+                rejectedByPrecheck = true;
+                return false;
+            }
+
+            swiftVerifier.verify(
+                databaseSegment,
+                querySegment,
+                swiftHits[hitID].delta,
+                onAlignmentResult,
+                stellar_kernel_runtime.verification_time,
+                verificationContext);
+            return true;
+        }); // measure_time
+
+        // swift hits skipped by the banded local score would not have produced a match either, they are not
+        // counted such that the statistics are the same as without the score batches
+        statistics.numRejectedSwiftHits += rejectedByPrecheck;
+        onSwiftHit(databaseSegment, querySegment, verified,
+                   stellar_kernel_runtime.verification_time._runtime - verificationTimeBefore);
+    }
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // Calls swift filter and verifies swift hits. = Computes eps-matches.
 // A basic block for stellar
-template<typename TAlphabet, typename TTag, typename TIsPatternDisabledFn, typename TOnAlignmentResultFn>
+// onSwiftHit(databaseSegment, querySegment, verified, verificationTime) is called after each swift hit.
+// For the local verification methods _bandedLocalPendingSize swift hits are collected before they are verified, such
+// that _bandedLocalMaxScores can group swift hits with similar band widths. Otherwise each swift hit is verified right
+// after it was found.
+template<typename TAlphabet, typename TTag, typename TIsQueryDisabledFn, typename TOnAlignmentResultFn, typename TOnSwiftHitFn>
 StellarComputeStatistics
 _stellarKernel(StellarSwiftFinder<TAlphabet> & finder,  // iterate over database
                StellarSwiftPattern<TAlphabet> & pattern,    // holds the query and preprocessing info
                SwiftHitVerifier<TTag> & swiftVerifier,
-               TIsPatternDisabledFn && isPatternDisabled,
+               TIsQueryDisabledFn && isQueryDisabled,
                TOnAlignmentResultFn && onAlignmentResult,
+               TOnSwiftHitFn && onSwiftHit,
                stellar_kernel_runtime & stellar_kernel_runtime) {
+    constexpr bool localVerification = std::is_same_v<TTag, AllLocal> || std::is_same_v<TTag, BestLocal>;
+    constexpr size_t batchSize = localVerification ? _bandedLocalPendingSize : 1u;
+
     StellarComputeStatistics statistics{};
+    std::vector<StellarSwiftHit<TAlphabet>> swiftHits{};
+    swiftHits.reserve(batchSize);
 
     while (true) {
 
@@ -282,39 +619,168 @@ _stellarKernel(StellarSwiftFinder<TAlphabet> & finder,  // iterate over database
             return find(finder, pattern, swiftVerifier.eps_match_options.epsilon, swiftVerifier.eps_match_options.minLength);
         });
 
+        if (has_next)
+        {
+            swiftHits.push_back(StellarSwiftHit<TAlphabet>{
+                StellarDatabaseSegment<TAlphabet>::fromFinderMatch(infix(finder)),
+                StellarQuerySegment<TAlphabet>::fromPatternMatch(pattern),
+                pattern.bucketParams[0].delta + pattern.bucketParams[0].overlap
+            });
+        }
+
+        if (swiftHits.size() == batchSize || !has_next)
+        {
+            _verifySwiftHits(std::span<StellarSwiftHit<TAlphabet> const>{swiftHits}, swiftVerifier, isQueryDisabled,
+                             onAlignmentResult, onSwiftHit, statistics, stellar_kernel_runtime);
+            swiftHits.clear();
+        }
+
         if (!has_next)
             break;
+    }
 
-        StellarDatabaseSegment<TAlphabet> databaseSegment
-            = StellarDatabaseSegment<TAlphabet>::fromFinderMatch(infix(finder));
+    return statistics;
+}
 
-        ++statistics.numSwiftHits;
-        statistics.totalLength += databaseSegment.size();
-        statistics.maxLength = std::max<size_t>(statistics.maxLength, databaseSegment.size());
+template<typename TAlphabet, typename TTag, typename TIsQueryDisabledFn, typename TOnAlignmentResultFn>
+StellarComputeStatistics
+_stellarKernel(StellarSwiftFinder<TAlphabet> & finder,
+               StellarSwiftPattern<TAlphabet> & pattern,
+               SwiftHitVerifier<TTag> & swiftVerifier,
+               TIsQueryDisabledFn && isQueryDisabled,
+               TOnAlignmentResultFn && onAlignmentResult,
+               stellar_kernel_runtime & stellar_kernel_runtime) {
+    auto onSwiftHit = [](auto const & ...){};
+    return _stellarKernel(finder, pattern, swiftVerifier, isQueryDisabled, onAlignmentResult, onSwiftHit,
+                          stellar_kernel_runtime);
+}
 
-        if (isPatternDisabled(pattern)) continue;
+///////////////////////////////////////////////////////////////////////////////
+// A part of a database segment that is scanned by its own swift finder.
+template <typename TAlphabet>
+struct StellarFinderRange
+{
+    StellarDatabaseSegment<TAlphabet> scanSegment; // warm-up prefix, the range itself and a cool-down suffix
+    size_t rangeBegin; // the finder keeps the swift hits that begin in [rangeBegin, rangeEnd)
+    size_t rangeEnd;
+};
 
-        StellarQuerySegment<TAlphabet> querySegment
-            = StellarQuerySegment<TAlphabet>::fromPatternMatch(pattern);
+///////////////////////////////////////////////////////////////////////////////
+// Returns the number of database positions that a finder has to scan before and after its range to find the swift
+// hits that begin in its range like a single finder over the whole segment.
+// A swift bucket covers the diagonals of a query only while the scan position is within the query length plus the
+// bucket width (delta + overlap), and a swift hit starts at most distanceCut + delta positions before the first q-gram
+// hit of its bucket. Repeats are masked by each finder on its own scan segment, a repeat that is cut by the scan
+// segment is masked the same way as long as at least minRepeatLength positions of it are scanned.
+inline size_t
+_finderRangeMargin(StellarOptions const & options, size_t const maxQueryLength)
+{
+    StellarStatistics const swiftStatistics{options};
+    return maxQueryLength + swiftStatistics.delta + swiftStatistics.overlap + // lifetime of a bucket
+           swiftStatistics.distanceCut + swiftStatistics.delta +             // begin of a hit before its bucket
+           options.minRepeatLength;
+}
 
-        ////Debug stuff:
-        //std::cout << beginPosition(finderInfix) << ",";
-        //std::cout << endPosition(finderInfix) << "  ";
-        //std::cout << beginPosition(patternSegment) << ",";
-        //std::cout << endPosition(patternSegment) << std::endl;
+///////////////////////////////////////////////////////////////////////////////
+// Splits a database segment into (at most) finderCount disjoint ranges.
+// All range boundaries are a multiple of bucketWidth away from the segment begin, such that each finder assigns the
+// diagonals to the same swift buckets as a single finder over the whole segment. Each range is scanned together with a
+// warm-up prefix and a cool-down suffix of marginLength (rounded up to a multiple of bucketWidth), see
+// _finderRangeMargin: the buckets are filled before the range begins and the buckets of hits that begin in the range
+// are flushed before the scan ends.
+template <typename TAlphabet>
+std::vector<StellarFinderRange<TAlphabet>>
+_partitionDatabaseSegment(StellarDatabaseSegment<TAlphabet> const & databaseSegment,
+                          size_t const finderCount,
+                          size_t const marginLength,
+                          size_t const bucketWidth)
+{
+    auto roundUp = [&](size_t const length) { return (length + bucketWidth - 1) / bucketWidth * bucketWidth; };
 
-        // verification
-        stellar_kernel_runtime.verification_time.measure_time([&]()
-        {
-            swiftVerifier.verify(
-                databaseSegment,
-                querySegment,
-                pattern.bucketParams[0].delta + pattern.bucketParams[0].overlap,
-                onAlignmentResult,
-                stellar_kernel_runtime.verification_time);
-        }); // measure_time
+    size_t const margin = roundUp(marginLength);
+    size_t const segmentLength = databaseSegment.size();
+
+    // ranges shorter than the margin would mostly re-scan the neighbouring ranges
+    size_t const count = std::max<size_t>(1u, std::min<size_t>(finderCount, segmentLength / std::max<size_t>(margin, 1u)));
+    size_t const rangeLength = roundUp((segmentLength + count - 1) / count);
+
+    std::vector<StellarFinderRange<TAlphabet>> finderRanges{};
+    for (size_t rangeBegin = 0; rangeBegin < segmentLength; rangeBegin += rangeLength)
+    {
+        size_t const rangeEnd = std::min(rangeBegin + rangeLength, segmentLength);
+        size_t const scanBegin = databaseSegment.beginPosition() + rangeBegin - std::min(rangeBegin, margin);
+        size_t const scanEnd = databaseSegment.beginPosition() + std::min(rangeEnd + margin, segmentLength);
+
+        finderRanges.push_back(StellarFinderRange<TAlphabet>{
+            StellarDatabaseSegment<TAlphabet>{databaseSegment.underlyingDatabase(), scanBegin, scanEnd},
+            databaseSegment.beginPosition() + rangeBegin,
+            databaseSegment.beginPosition() + rangeEnd
+        });
     }
 
+    return finderRanges;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Calls swift filter and verifies swift hits like the basic _stellarKernel, but scans each finder range with its own
+// swift finder and its own copy of the pattern in parallel. Each swift hit is kept by the finder in whose range it
+// begins, such that the swift hits are the same as the ones of a single finder over the whole segment. The swift hits
+// are verified afterwards in the order of the finder ranges.
+// All swift hits are found before the first one is verified, so isQueryDisabled only skips the verification of swift
+// hits of disabled queries, not their filtering.
+template<typename TAlphabet, typename TTag, typename TIsQueryDisabledFn, typename TOnAlignmentResultFn, typename TOnSwiftHitFn>
+StellarComputeStatistics
+_stellarKernel(std::vector<StellarFinderRange<TAlphabet>> const & finderRanges,
+               unsigned const minRepeatLength,
+               unsigned const maxRepeatPeriod,
+               StellarSwiftPattern<TAlphabet> & pattern,    // is copied for each finder
+               SwiftHitVerifier<TTag> & swiftVerifier,
+               TIsQueryDisabledFn && isQueryDisabled,
+               TOnAlignmentResultFn && onAlignmentResult,
+               TOnSwiftHitFn && onSwiftHit,
+               stellar_kernel_runtime & stellar_kernel_runtime) {
+    using TSwiftHit = StellarSwiftHit<TAlphabet>;
+
+    std::vector<std::vector<TSwiftHit>> finderSwiftHits(finderRanges.size());
+
+    // all pattern copies share the q-gram index, make sure it is not built concurrently
+    indexRequire(host(pattern), QGramSADir());
+
+    stellar_kernel_runtime.swift_filter_time.measure_time([&]()
+    {
+        #pragma omp parallel for schedule(dynamic, 1)
+        for (size_t finderID = 0; finderID < finderRanges.size(); ++finderID)
+        {
+            StellarFinderRange<TAlphabet> const & finderRange = finderRanges[finderID];
+            StellarSwiftFinder<TAlphabet> finder(finderRange.scanSegment.asInfixSegment(), minRepeatLength, maxRepeatPeriod);
+            StellarSwiftPattern<TAlphabet> finderPattern = pattern;
+
+            while (find(finder, finderPattern, swiftVerifier.eps_match_options.epsilon, swiftVerifier.eps_match_options.minLength))
+            {
+                StellarDatabaseSegment<TAlphabet> databaseSegment
+                    = StellarDatabaseSegment<TAlphabet>::fromFinderMatch(infix(finder));
+
+                // found (maybe only partially) by the finder of the previous or of the next range
+                if (databaseSegment.beginPosition() < finderRange.rangeBegin ||
+                    databaseSegment.beginPosition() >= finderRange.rangeEnd)
+                    continue;
+
+                finderSwiftHits[finderID].push_back(TSwiftHit{
+                    databaseSegment,
+                    StellarQuerySegment<TAlphabet>::fromPatternMatch(finderPattern),
+                    finderPattern.bucketParams[0].delta + finderPattern.bucketParams[0].overlap
+                });
+            }
+        }
+    }); // measure_time
+
+    std::vector<TSwiftHit> swiftHits{};
+    for (std::vector<TSwiftHit> const & hits : finderSwiftHits)
+        swiftHits.insert(swiftHits.end(), hits.begin(), hits.end());
+
+    StellarComputeStatistics statistics{};
+    _verifySwiftHits(std::span<TSwiftHit const>{swiftHits}, swiftVerifier, isQueryDisabled, onAlignmentResult,
+                     onSwiftHit, statistics, stellar_kernel_runtime);
     return statistics;
 }
 
@@ -0,0 +1,417 @@
+
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <ranges>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <stellar/stellar_output.hpp>
+
+namespace stellar
+{
+
+// The binary match format (file extension smb) stores the matches in fixed-width records, such that the matches
+// can be written and read without formatting or parsing numbers. The file consists of
+//   1. a StellarBinaryHeader,
+//   2. the string tables of the short database ids and of the short query ids,
+//   3. any number of blocks, each a StellarBinaryBlockHeader followed by the matches, edit runs and mutations of
+//      the block.
+// A string table is the number of strings n, the number of chars, n + 1 offsets (uint64_t) and the chars.
+// All numbers are stored little endian.
+static_assert(std::endian::native == std::endian::little, "The binary match format is only supported on little "
+                                                          "endian systems.");
+
+struct StellarBinaryHeader
+{
+    static constexpr char fileMagic[8] = {'S', 'T', 'E', 'L', 'L', 'A', 'R', 'M'};
+    static constexpr uint32_t fileVersion = 1u;
+    static constexpr uint32_t hasEValues = 1u; // flag: the alphabet is Dna5 or Rna5, the matches have e-values
+
+    char magic[8];
+    uint32_t version;
+    uint32_t flags;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+// A match of the binary match format. Database positions are on the forward strand, i.e. the gff positions are
+// databaseBegin + 1 and databaseEnd. The edit runs and mutations are ranges of the block of the match.
+struct StellarBinaryMatch
+{
+    uint64_t databaseBegin;
+    uint64_t databaseEnd;
+    uint64_t queryBegin;
+    uint64_t queryEnd;
+    double identity;
+    double eValue;
+    uint32_t databaseIndex;
+    uint32_t queryIndex;
+    uint64_t editRunsBegin;
+    uint32_t editRunsLength;
+    uint32_t mutationsLength;
+    uint64_t mutationsBegin;
+    uint8_t databaseStrand; // 1 = forward, 0 = reverse complement
+    uint8_t padding[7];
+};
+
+static_assert(sizeof(StellarBinaryMatch) == 88u);
+
+// The mutations are stored as StellarMutation records.
+static_assert(sizeof(StellarMutation) == 8u);
+
+struct StellarBinaryBlockHeader
+{
+    uint64_t matchCount;
+    uint64_t editRunCount;
+    uint64_t mutationCount;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+// Edit runs are stored as the kind in the upper two bits and the count in the lower 30 bits.
+inline uint32_t
+_encodeBinaryEditRun(StellarEditRun const editRun)
+{
+    return (uint32_t{editRun.kind} << 30) | editRun.count;
+}
+
+inline StellarEditRun
+_decodeBinaryEditRun(uint32_t const encoded)
+{
+    return StellarEditRun{encoded >> 30, encoded & ((uint32_t{1u} << 30) - 1u)};
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// The matches, edit runs and mutations of a block.
+struct StellarBinaryMatches
+{
+    std::vector<StellarBinaryMatch> matches{};
+    std::vector<uint32_t> editRuns{};
+    std::vector<StellarMutation> mutations{};
+
+    void clear()
+    {
+        matches.clear();
+        editRuns.clear();
+        mutations.clear();
+    }
+
+    // appends the matches of other, their edit runs and mutations are moved behind the ones of this block
+    void append(StellarBinaryMatches const & other)
+    {
+        size_t const matchesBegin = matches.size();
+        matches.insert(matches.end(), other.matches.begin(), other.matches.end());
+        for (size_t i = matchesBegin; i < matches.size(); ++i) {
+            matches[i].editRunsBegin += editRuns.size();
+            matches[i].mutationsBegin += mutations.size();
+        }
+        editRuns.insert(editRuns.end(), other.editRuns.begin(), other.editRuns.end());
+        mutations.insert(mutations.end(), other.mutations.begin(), other.mutations.end());
+    }
+};
+
+///////////////////////////////////////////////////////////////////////////////
+// Short ids of a string table of a binary match file.
+struct StellarBinaryStringTable
+{
+    std::vector<uint64_t> offsets{0u};
+    std::string chars{};
+
+    size_t size() const
+    {
+        return offsets.size() - 1u;
+    }
+
+    std::string_view operator[](size_t const index) const
+    {
+        return std::string_view{chars}.substr(offsets[index], offsets[index + 1] - offsets[index]);
+    }
+};
+
+template <typename TValue>
+inline void
+_writeBinary(std::ostream & file, TValue const * values, size_t const count)
+{
+    file.write(reinterpret_cast<char const *>(values), count * sizeof(TValue));
+}
+
+template <typename TValue>
+inline bool
+_readBinary(std::istream & file, TValue * values, size_t const count)
+{
+    file.read(reinterpret_cast<char *>(values), count * sizeof(TValue));
+    return file.gcount() == static_cast<std::streamsize>(count * sizeof(TValue));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Reads count values into values. The values grow with the data that was read, such that a corrupt count fails at
+// the end of the file instead of allocating memory for count values.
+template <typename TContainer>
+inline bool
+_readBinaryValues(std::istream & file, TContainer & values, uint64_t const count)
+{
+    constexpr uint64_t chunkSize = (uint64_t{1u} << 20) / sizeof(typename TContainer::value_type);
+
+    values.clear();
+    for (uint64_t valuesRead = 0; valuesRead < count; valuesRead += chunkSize) {
+        size_t const chunk = std::min(count - valuesRead, chunkSize);
+        values.resize(valuesRead + chunk);
+        if (!_readBinary(file, values.data() + valuesRead, chunk))
+            return false;
+    }
+    return true;
+}
+
+template <typename TId>
+void _writeBinaryStringTable(StringSet<TId> const & ids, std::ostream & file)
+{
+    StellarBinaryStringTable table{};
+    for (TId const & id : ids) {
+        table.chars.append(_shortIdView(id));
+        table.offsets.push_back(table.chars.size());
+    }
+
+    uint64_t const counts[2] = {table.size(), table.chars.size()};
+    _writeBinary(file, counts, 2u);
+    _writeBinary(file, table.offsets.data(), table.offsets.size());
+    _writeBinary(file, table.chars.data(), table.chars.size());
+}
+
+inline bool
+_readBinaryStringTable(std::istream & file, StellarBinaryStringTable & table)
+{
+    uint64_t counts[2];
+    if (!_readBinary(file, counts, 2u) || counts[0] == std::numeric_limits<uint64_t>::max())
+        return false;
+
+    return _readBinaryValues(file, table.offsets, counts[0] + 1u) &&
+           _readBinaryValues(file, table.chars, counts[1]) &&
+           table.offsets.front() == 0u && table.offsets.back() == table.chars.size() &&
+           std::is_sorted(table.offsets.begin(), table.offsets.end());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Writes the header and the string tables of a binary match file.
+template <typename TAlphabet, typename TId>
+void _writeBinaryMatchesHeader(StringSet<TId> const & databaseIDs, StringSet<TId> const & queryIDs,
+                               std::ostream & file)
+{
+    StellarBinaryHeader header{};
+    std::memcpy(header.magic, StellarBinaryHeader::fileMagic, sizeof(header.magic));
+    header.version = StellarBinaryHeader::fileVersion;
+    if (IsSameType<TAlphabet, Dna5>::VALUE || IsSameType<TAlphabet, Rna5>::VALUE)
+        header.flags |= StellarBinaryHeader::hasEValues;
+
+    _writeBinary(file, &header, 1u);
+    _writeBinaryStringTable(databaseIDs, file);
+    _writeBinaryStringTable(queryIDs, file);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Reads the header and the string tables of a binary match file.
+inline bool
+_readBinaryMatchesHeader(std::istream & file,
+                         StellarBinaryHeader & header,
+                         StellarBinaryStringTable & databaseIDs,
+                         StellarBinaryStringTable & queryIDs)
+{
+    if (!_readBinary(file, &header, 1u) ||
+        std::memcmp(header.magic, StellarBinaryHeader::fileMagic, sizeof(header.magic)) != 0)
+    {
+        std::cerr << "ERROR: Not a binary STELLAR match file." << std::endl;
+        return false;
+    }
+
+    if (header.version != StellarBinaryHeader::fileVersion)
+    {
+        std::cerr << "ERROR: Unsupported version " << header.version << " of binary STELLAR match file." << std::endl;
+        return false;
+    }
+
+    if (!_readBinaryStringTable(file, databaseIDs) || !_readBinaryStringTable(file, queryIDs))
+    {
+        std::cerr << "ERROR: Corrupt string table in binary STELLAR match file." << std::endl;
+        return false;
+    }
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Appends a StellarMatch with its edit script and mutations to a block. The fields are computed by _gffRecord and
+// _appendMutations like for the gff output.
+template <typename TSize, typename TMatch>
+void _appendBinaryMatch(StellarBinaryMatches & block,
+                        uint32_t const queryIndex,
+                        TSize const lengthAdjustment,
+                        TMatch const & match,
+                        String<StellarEditRun> const & editScripts)
+{
+    StellarGffRecord const gffRecord = _gffRecord(match, lengthAdjustment);
+
+    StellarBinaryMatch record{};
+    record.databaseIndex = match.databaseRecordID;
+    record.queryIndex = queryIndex;
+    record.databaseStrand = gffRecord.databaseStrand;
+    record.databaseBegin = gffRecord.databaseBegin;
+    record.databaseEnd = gffRecord.databaseEnd;
+    record.queryBegin = gffRecord.queryBegin;
+    record.queryEnd = gffRecord.queryEnd;
+    record.identity = gffRecord.identity;
+    record.eValue = gffRecord.eValue;
+    record.editRunsBegin = block.editRuns.size();
+    record.mutationsBegin = block.mutations.size();
+
+    for (StellarEditRun const editRun : _editScript(match, editScripts))
+        block.editRuns.push_back(_encodeBinaryEditRun(editRun));
+    _appendMutations(match, editScripts, block.mutations);
+
+    record.editRunsLength = block.editRuns.size() - record.editRunsBegin;
+    record.mutationsLength = block.mutations.size() - record.mutationsBegin;
+    block.matches.push_back(record);
+}
+
+inline void
+_writeBinaryMatchesBlock(StellarBinaryMatches const & block, std::ostream & file)
+{
+    StellarBinaryBlockHeader const blockHeader{block.matches.size(), block.editRuns.size(), block.mutations.size()};
+    _writeBinary(file, &blockHeader, 1u);
+    _writeBinary(file, block.matches.data(), block.matches.size());
+    _writeBinary(file, block.editRuns.data(), block.editRuns.size());
+    _writeBinary(file, block.mutations.data(), block.mutations.size());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Reads the next block of a binary match file. Returns false at the end of the file or if the block is corrupt,
+// corrupt is set in the latter case.
+inline bool
+_readBinaryMatchesBlock(std::istream & file,
+                        StellarBinaryStringTable const & databaseIDs,
+                        StellarBinaryStringTable const & queryIDs,
+                        StellarBinaryMatches & block,
+                        bool & corrupt)
+{
+    StellarBinaryBlockHeader blockHeader;
+    corrupt = false;
+    if (!_readBinary(file, &blockHeader, 1u)) {
+        corrupt = file.gcount() != 0;
+        return false;
+    }
+
+    corrupt = !_readBinaryValues(file, block.matches, blockHeader.matchCount) ||
+              !_readBinaryValues(file, block.editRuns, blockHeader.editRunCount) ||
+              !_readBinaryValues(file, block.mutations, blockHeader.mutationCount);
+    if (corrupt)
+        return false;
+
+    for (StellarBinaryMatch const & match : block.matches) {
+        corrupt = corrupt ||
+                  match.databaseIndex >= databaseIDs.size() || match.queryIndex >= queryIDs.size() ||
+                  match.editRunsBegin > block.editRuns.size() ||
+                  match.editRunsLength > block.editRuns.size() - match.editRunsBegin ||
+                  match.mutationsBegin > block.mutations.size() ||
+                  match.mutationsLength > block.mutations.size() - match.mutationsBegin;
+    }
+    return !corrupt;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Appends a match of a binary match file in gff format to buffer, byte-identical to the gff output of the
+// StellarMatch it was written from.
+inline void
+_appendBinaryMatchGff(std::string & buffer,
+                      StellarBinaryHeader const & header,
+                      StellarBinaryStringTable const & databaseIDs,
+                      StellarBinaryStringTable const & queryIDs,
+                      StellarBinaryMatches const & block,
+                      StellarBinaryMatch const & match)
+{
+    StellarGffRecord record{};
+    record.databaseID = databaseIDs[match.databaseIndex];
+    record.queryID = queryIDs[match.queryIndex];
+    record.databaseBegin = match.databaseBegin;
+    record.databaseEnd = match.databaseEnd;
+    record.queryBegin = match.queryBegin;
+    record.queryEnd = match.queryEnd;
+    record.identity = match.identity;
+    record.eValue = match.eValue;
+    record.databaseStrand = match.databaseStrand;
+    record.hasEValue = header.flags & StellarBinaryHeader::hasEValues;
+
+    std::span<uint32_t const> const editRuns{block.editRuns.data() + match.editRunsBegin, match.editRunsLength};
+    std::span<StellarMutation const> const mutations{block.mutations.data() + match.mutationsBegin,
+                                                     match.mutationsLength};
+    StellarGffFormatter::appendRecord(buffer, record, editRuns | std::views::transform(_decodeBinaryEditRun),
+                                      mutations);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Writes all matches of a binary match file in gff format.
+inline bool
+_convertBinaryMatchesToGff(std::istream & binaryFile, std::ostream & gffFile)
+{
+    StellarBinaryHeader header;
+    StellarBinaryStringTable databaseIDs;
+    StellarBinaryStringTable queryIDs;
+    if (!_readBinaryMatchesHeader(binaryFile, header, databaseIDs, queryIDs))
+        return false;
+
+    StellarBinaryMatches block;
+    std::string buffer;
+    bool corrupt = false;
+    while (_readBinaryMatchesBlock(binaryFile, databaseIDs, queryIDs, block, corrupt)) {
+        buffer.clear();
+        for (StellarBinaryMatch const & match : block.matches)
+            _appendBinaryMatchGff(buffer, header, databaseIDs, queryIDs, block, match);
+        gffFile.write(buffer.data(), buffer.size());
+    }
+
+    if (corrupt)
+        std::cerr << "ERROR: Corrupt block of matches in binary STELLAR match file." << std::endl;
+    return !corrupt;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Writes the matches of all queries in the binary match format, in the same order as _writeAllQueryMatchesToFile.
+// The matches of a batch of queries are converted in parallel and written as one block.
+template <typename TInfix, typename TQueryId>
+void _writeAllQueryMatchesToBinaryFile(StringSet<QueryMatches<StellarMatch<TInfix const, TQueryId> > > const & matches,
+                                       bool const orientation, std::ostream & outputFile)
+{
+    size_t const queryCount = length(matches);
+    std::vector<StellarBinaryMatches> queryBlocks(std::min(queryCount, _outputQueryBatchSize));
+    StellarBinaryMatches block;
+
+    for (size_t batchBegin = 0; batchBegin < queryCount; batchBegin += _outputQueryBatchSize) {
+        size_t const batchSize = std::min(queryCount - batchBegin, _outputQueryBatchSize);
+
+        #pragma omp parallel for schedule(dynamic, 1)
+        for (size_t j = 0; j < batchSize; ++j) {
+            size_t const i = batchBegin + j;
+            QueryMatches<StellarMatch<TInfix const, TQueryId>> const & queryMatches = value(matches, i);
+
+            queryBlocks[j].clear();
+            for (StellarMatch<TInfix const, TQueryId> const & match : queryMatches.matches) {
+                if (match.orientation != orientation)
+                    continue;
+
+                _appendBinaryMatch(queryBlocks[j], i, queryMatches.lengthAdjustment, match,
+                                   queryMatches.editScripts);
+            }
+        }
+
+        block.clear();
+        for (size_t j = 0; j < batchSize; ++j)
+            block.append(queryBlocks[j]);
+
+        if (!block.matches.empty())
+            _writeBinaryMatchesBlock(block, outputFile);
+    }
+}
+
+} // namespace stellar
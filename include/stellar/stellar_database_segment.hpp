@@ -1,6 +1,8 @@
 
 #pragma once
 
+#include <random>
+
 #include <seqan/seq_io.h>
 
 #include <stellar/stellar_sequence_segment.hpp>
@@ -79,4 +81,40 @@ TStorage _getDatabaseSegments(StringSet<String<TAlphabet>> & databases, StellarO
     return databaseSegments;
 }
 
+// Draws windows of windowLength from the given database segments, such that about sampleLength database positions are
+// covered. Each window starts at a uniformly chosen position of the concatenated segments. The seed is fixed to make
+// the sample reproducible. If the segments are not longer than sampleLength, all of them are returned.
+template <typename TAlphabet, typename TStorage>
+TStorage _sampleDatabaseSegments(TStorage const & databaseSegments, size_t const sampleLength, size_t const windowLength)
+{
+    size_t totalLength{0u};
+    for (StellarDatabaseSegment<TAlphabet> const & databaseSegment : databaseSegments)
+        totalLength += databaseSegment.size();
+
+    if (totalLength <= sampleLength || windowLength == 0u)
+        return databaseSegments;
+
+    std::mt19937_64 randomEngine{0x57e11a5u};
+    std::uniform_int_distribution<size_t> positionDistribution{0u, totalLength - 1u};
+
+    TStorage sampleSegments{};
+    for (size_t sampledLength = 0u; sampledLength < sampleLength;)
+    {
+        size_t position = positionDistribution(randomEngine);
+
+        auto segmentIt = databaseSegments.begin();
+        for (; position >= segmentIt->size(); ++segmentIt)
+            position -= segmentIt->size();
+
+        StellarDatabaseSegment<TAlphabet> const & databaseSegment = *segmentIt;
+        size_t const length = std::min(windowLength, databaseSegment.size());
+        size_t const beginPosition = databaseSegment.beginPosition() + std::min(position, databaseSegment.size() - length);
+
+        sampleSegments.emplace_back(databaseSegment.underlyingDatabase(), beginPosition, beginPosition + length);
+        sampledLength += length;
+    }
+
+    return sampleSegments;
+}
+
 } // namespace stellar
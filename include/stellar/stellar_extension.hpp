@@ -25,6 +25,7 @@
 #define SEQAN_HEADER_STELLAR_EXTENSION_H
 
 #include <stellar/extension/align_banded_nw_best_ends.hpp>
+#include <stellar/extension/extension_buffers.hpp>
 #include <stellar/extension/extension_end_position.hpp>
 #include <stellar/extension/longest_eps_match.hpp>
 #include <stellar/utils/stellar_kernel_runtime.hpp>
@@ -110,17 +111,18 @@ _isEpsMatch(Triple<TPos, TPos, TPos> const & left,
 ///////////////////////////////////////////////////////////////////////////////
 // Identifies the longest epsilon match in align and sets the view positions of
 // align to start and end position of the longest epsilon match
-template<typename TSource, typename TSize, typename TFloat>
+// gaps is a buffer that is cleared before use.
+template<typename TSource, typename TSize, typename TFloat, typename TPosition>
 bool
 longestEpsMatch(Align<TSource> & align,
                 TSize const matchMinLength,
-                TFloat const epsilon) {
+                TFloat const epsilon,
+                String<Triple<TPosition, TPosition, TPosition> > & gaps) {
     // Preprocessing: compute and store gaps and lengths
     // A gap is a triple of gap begin position, gap end position, and total number of errors in sequence from begin
     //   to end position of this gap.
-    typedef typename Position<Align<TSource> >::Type TPosition;
     typedef String<Triple<TPosition, TPosition, TPosition> > TGapsString;
-    TGapsString gaps;
+    clear(gaps);
     _fillGapsString(align, gaps);
 
     // Identify longest eps match by iterating over combinations of left and right positions
@@ -164,6 +166,16 @@ longestEpsMatch(Align<TSource> & align,
     return 0;
 }
 
+template<typename TSource, typename TSize, typename TFloat>
+bool
+longestEpsMatch(Align<TSource> & align,
+                TSize const matchMinLength,
+                TFloat const epsilon) {
+    typedef typename Position<Align<TSource> >::Type TPosition;
+    String<Triple<TPosition, TPosition, TPosition> > gaps;
+    return longestEpsMatch(align, matchMinLength, epsilon, gaps);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // Computes the banded alignment matrix for the left extension and
 //   returns a string with possible start positions of an eps-match.
@@ -171,10 +183,12 @@ template<typename TMatrix, typename TPossEnd, typename TAlphabet, typename TDiag
 void
 _fillMatrixBestEndsLeft(TMatrix & matrixLeft,
                         String<TPossEnd> & possibleEndsLeft,
-                        StringSet<Segment<String<TAlphabet> const, InfixSegment>> const & sequencesLeft,
+                        StringSet<ModifiedString<Segment<String<TAlphabet> const, InfixSegment>, ModReverse>> const & sequencesLeft,
                         TDiagonal const diagLower,
                         TDiagonal const diagUpper,
-                        TScore const & scoreMatrix) {
+                        TScore const & scoreMatrix,
+                        typename Value<TScore>::Type const scoreDropOff,
+                        AlignBandedNwBestEndsBuffers<typename Value<TScore>::Type> & bandedNwBuffers) {
     // _align_banded_nw_best_ends(matrixLeft, possibleEndsLeft, str, scoreMatrix,
     //                            upperDiagonal(seedOld) - upperDiagonal(seed),
     //                            upperDiagonal(seedOld) - lowerDiagonal(seed));
@@ -191,7 +205,8 @@ _fillMatrixBestEndsLeft(TMatrix & matrixLeft,
 
     // Use legacy adapted NW computation with infixH/first alignment row being in the vertical direction.
     // // TODO(holtgrew): When switching to DP from new alignment module, make sure to mirror diagonals.
-    _align_banded_nw_best_ends(matrixLeft, possibleEndsLeft, sequencesLeft, scoreMatrix, -diagUpper, -diagLower);
+    _align_banded_nw_best_ends_xdrop(matrixLeft, possibleEndsLeft, sequencesLeft, _unitMatchScore(scoreMatrix),
+                                     -diagUpper, -diagLower, scoreDropOff, bandedNwBuffers);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -204,7 +219,9 @@ _fillMatrixBestEndsRight(TMatrix & matrixRight,
                          StringSet<Segment<String<TAlphabet> const, InfixSegment>> const & sequencesRight,
                          TDiagonal const diagLower,
                          TDiagonal const diagUpper,
-                         TScore const & scoreMatrix) {
+                         TScore const & scoreMatrix,
+                         typename Value<TScore>::Type const scoreDropOff,
+                         AlignBandedNwBestEndsBuffers<typename Value<TScore>::Type> & bandedNwBuffers) {
     // std::cerr << "FILL MATRIX RIGHT SEQS\n"
     //           << "0: " << infixH << "\n"
     //           << "1: " << infixV << "\n";
@@ -221,7 +238,8 @@ _fillMatrixBestEndsRight(TMatrix & matrixRight,
 
     // Use legacy adapted NW computation with infixH/first alignment row being in the vertical direction.
     // TODO(holtgrew): When switching to DP from new alignment module, make sure to mirror diagonals.
-    _align_banded_nw_best_ends(matrixRight, possibleEndsRight, sequencesRight, scoreMatrix, -diagUpper, -diagLower);
+    _align_banded_nw_best_ends_xdrop(matrixRight, possibleEndsRight, sequencesRight, _unitMatchScore(scoreMatrix),
+                                     -diagUpper, -diagLower, scoreDropOff, bandedNwBuffers);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -259,7 +277,7 @@ _alignBandedNeedlemanWunschTrace(TAlign & align,
 
     if ((actualRow != 0) && (actualCol != 0)) {
         // Find initial direction
-        TTraceValue tv = trace[row * diagonalWidth + col];
+        TTraceValue tv = _getTraceValue(trace, row * diagonalWidth + col);
         if (tv == Horizontal) --col;
         else if (tv == Vertical) {--row; ++col;}
         else --row;
@@ -270,7 +288,7 @@ _alignBandedNeedlemanWunschTrace(TAlign & align,
         while(true) {
             actualRow = row + lo_row;
             actualCol = col + diagL + actualRow;
-            newTv = trace[row * diagonalWidth + col];
+            newTv = _getTraceValue(trace, row * diagonalWidth + col);
 
             // Check if we hit a border
             if ((actualRow == 0) || (actualCol == 0)) break;
@@ -359,15 +377,18 @@ template<typename TMatrix, typename TCoord, typename TAlphabet, typename TBeginP
 void
 _tracebackLeft(TMatrix const & matrixLeft,
                TCoord const & coordinate,
-               StringSet<Segment<String<TAlphabet> const, InfixSegment>> const & sequencesLeft,
+               StringSet<ModifiedString<Segment<String<TAlphabet> const, InfixSegment>, ModReverse>> const & sequencesLeft,
                TBeginPosition const infixAlignHBeginPosition,
                TBeginPosition const infixAlignVBeginPosition,
                TDiagonal const diagLower,
                TDiagonal const diagUpper,
                TPos const endLeftH,
                TPos const endLeftV,
-               TAlign & align) {
-    AlignTraceback<TPos> traceBack;
+               TAlign & align,
+               AlignTraceback<TPos> & traceBack,
+               Align<Segment<String<TAlphabet> const, InfixSegment>> & infixAlign) {
+    clear(traceBack.sizes);
+    clear(traceBack.tvs);
     _alignBandedNeedlemanWunschTrace(traceBack, sequencesLeft, matrixLeft, coordinate,
                                      -diagUpper, -diagLower);
                                      // upperDiagonal(seedOld) - upperDiagonal(seed), upperDiagonal(seedOld) - lowerDiagonal(seed));
@@ -379,10 +400,12 @@ _tracebackLeft(TMatrix const & matrixLeft,
     reverse(traceBack.sizes);
     reverse(traceBack.tvs);
 
-    Align<Segment<String<TAlphabet> const, InfixSegment>> infixAlign;
+    // the reversed trace belongs to the (not reversed) sequences left of the eps-core
+    Segment<String<TAlphabet> const, InfixSegment> const & infixLeftH = host(sequencesLeft[0]);
+    Segment<String<TAlphabet> const, InfixSegment> const & infixLeftV = host(sequencesLeft[1]);
     resize(rows(infixAlign), 2);
-    assignSource(row(infixAlign, 0), infix(sequencesLeft[0], length(sequencesLeft[0]) - endLeftH, length(sequencesLeft[0])));
-    assignSource(row(infixAlign, 1), infix(sequencesLeft[1], length(sequencesLeft[1]) - endLeftV, length(sequencesLeft[1])));
+    assignSource(row(infixAlign, 0), infix(infixLeftH, length(infixLeftH) - endLeftH, length(infixLeftH)));
+    assignSource(row(infixAlign, 1), infix(infixLeftV, length(infixLeftV) - endLeftV, length(infixLeftV)));
 
     // std::cerr << "\nLEFT SEQS\n" << row(infixAlign, 0) << "\n" << row(infixAlign, 1) << "\n";
     _pumpTraceToGaps(row(infixAlign, 0), row(infixAlign, 1), traceBack);
@@ -407,8 +430,11 @@ _tracebackRight(TMatrix const & matrixRight,
                TDiagonal const diagUpper,
                TPos const endRightH,
                TPos const endRightV,
-               TAlign & align) {
-    AlignTraceback<TPos> traceBack;
+               TAlign & align,
+               AlignTraceback<TPos> & traceBack,
+               Align<Segment<String<TAlphabet> const, InfixSegment>> & infixAlign) {
+    clear(traceBack.sizes);
+    clear(traceBack.tvs);
     _alignBandedNeedlemanWunschTrace(traceBack, sequencesRight, matrixRight, coordinate,
                                      -diagUpper, -diagLower);
                 // lowerDiagonal(seedOld) - upperDiagonal(seed), lowerDiagonal(seedOld) - lowerDiagonal(seed));
@@ -417,7 +443,6 @@ _tracebackRight(TMatrix const & matrixRight,
   //  std::cerr << (int)traceBack.tvs[i] << "\t" << traceBack.sizes[i] << "\n";
   //std::cerr << "---------\n";
 
-    Align<Segment<String<TAlphabet> const, InfixSegment>> infixAlign;
     resize(rows(infixAlign), 2);
     assignSource(row(infixAlign, 0), infix(sequencesRight[0], 0, endRightH));
     assignSource(row(infixAlign, 1), infix(sequencesRight[1], 0, endRightV));
@@ -430,6 +455,21 @@ _tracebackRight(TMatrix const & matrixRight,
     // std::cerr << "ALIGN AFTER INTEGRATION WITH INFIX ALIGN\n\n" << align << "\n";
 }
 
+// extensions with larger trace matrices (in cells) only keep the best ends in a first pass, see _bestExtension
+constexpr size_t _maxStoredExtensionTraceCells = size_t{1u} << 22;
+
+///////////////////////////////////////////////////////////////////////////////
+// Returns true if the trace matrix of an extension is too large to be stored for the whole extension. Then the
+// first pass over the extension computes only the best ends, and the trace is recomputed for the rows up to the
+// chosen end (the only rows the traceback visits) after longestEpsMatch picked it. The recomputation keeps the
+// whole horizontal sequence, so that the X-drop pruning drops the same cells as in the first pass.
+template <typename TStringSet, typename TDiagonal>
+inline bool
+_recomputeExtensionTrace(TStringSet const & sequences, TDiagonal const diagLower, TDiagonal const diagUpper)
+{
+    return (length(sequences[1]) + 1) * (size_t)(diagUpper - diagLower + 1) > _maxStoredExtensionTraceCells;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // Computes the banded alignment matrix and fills a string with possible start
 //   and end positions of an eps-match. Determines the optimal start and end
@@ -444,20 +484,25 @@ _bestExtension(Segment<TSequence const, InfixSegment> const & infH,
                TPos const alignLen,
                TPos const alignErr,
                TScore const & scoreMatrix,
+               typename Value<TScore>::Type const scoreDropOff,
                TDir const direction,
                TSize const minLength,
                TEps const eps,
                TAlign & align,
+               StellarExtensionBuffers<TSequence> & buffers,
                stellar_best_extension_time & best_extension_runtime)
 {
-    typedef String<TraceBack>                               TAlignmentMatrix;
     typedef ExtensionEndPosition<TPos>                      TEndInfo;
     typedef typename Iterator<String<TEndInfo> const>::Type TEndIterator;
     typedef typename Diagonal<TSeed>::Type                  TDiagonal;
 
     // variables for banded alignment and possible ends of match
-    TAlignmentMatrix matrixRight, matrixLeft;
-    String<TEndInfo> possibleEndsLeft, possibleEndsRight;
+    auto & matrixRight = buffers.matrixRight;
+    auto & matrixLeft = buffers.matrixLeft;
+    auto & possibleEndsLeft = buffers.possibleEndsLeft;
+    auto & possibleEndsRight = buffers.possibleEndsRight;
+    clear(possibleEndsLeft);
+    clear(possibleEndsRight);
 
     // new extension to the left of the old seed
     assert(beginPositionH(seed) <= beginPositionH(seedOld)); // infixLeftH
@@ -471,10 +516,11 @@ _bestExtension(Segment<TSequence const, InfixSegment> const & infH,
     assert(endPositionH(seedOld) <= endPositionH(seed)); // infixRightH
     assert(endPositionV(seedOld) <= endPositionV(seed)); // infixRightV
 
-    TSequence sequenceCopyLeftH;
-    TSequence sequenceCopyLeftV;
-    StringSet<Segment<TSequence const, InfixSegment>> sequencesLeft;
-    StringSet<Segment<TSequence const, InfixSegment>> sequencesRight;
+    using TReverseInfix = typename StellarExtensionBuffers<TSequence>::TReverseInfix;
+    StringSet<TReverseInfix> & sequencesLeft = buffers.sequencesLeft;
+    StringSet<Segment<TSequence const, InfixSegment>> & sequencesRight = buffers.sequencesRight;
+    clear(sequencesLeft);
+    clear(sequencesRight);
 
     // Compute diagonals for updated seeds module with infixH/first alignment row being in the horizontal direction.
     TDiagonal const diagLowerLeft = lowerDiagonal(seedOld) - upperDiagonal(seed);
@@ -484,31 +530,38 @@ _bestExtension(Segment<TSequence const, InfixSegment> const & infH,
     TDiagonal const diagLowerRight = upperDiagonal(seedOld) - upperDiagonal(seed);
     TDiagonal const diagUpperRight = upperDiagonal(seedOld) - lowerDiagonal(seed);
 
+    // whether the trace matrices are only computed for the chosen ends, see _recomputeExtensionTrace
+    bool recomputeTraceLeft = false;
+    bool recomputeTraceRight = false;
+
     best_extension_runtime.banded_needleman_wunsch_time.measure_time([&]()
     {
     // fill banded matrix and gaps string for ...
     if (direction == EXTEND_BOTH || direction == EXTEND_LEFT) { // ... extension to the left
         best_extension_runtime.banded_needleman_wunsch_left_time.measure_time([&]()
         {
-        // prepare copy segment...
-        reserve(sequenceCopyLeftH, beginPositionH(seedOld) - beginPositionH(seed));
-        reserve(sequenceCopyLeftV, beginPositionV(seedOld) - beginPositionV(seed));
-
-        // ...copy segment...
         //!TODO: where is this host() from
         // does it return the complete database for a segment?
-        append(sequenceCopyLeftH, infix(host(infH), beginPositionH(seed), beginPositionH(seedOld)));
-        append(sequenceCopyLeftV, infix(host(infV), beginPositionV(seed), beginPositionV(seedOld)));
+        buffers.infixLeftH = infix(host(infH), beginPositionH(seed), beginPositionH(seedOld));
+        buffers.infixLeftV = infix(host(infV), beginPositionV(seed), beginPositionV(seedOld));
 
-        // ...and reverse local copy
-        reverse(sequenceCopyLeftH);
-        reverse(sequenceCopyLeftV);
+        // the left extension aligns the reversed segments; the reverse views don't copy them and refer to the
+        // segments in buffers, which outlive sequencesLeft
+        appendValue(sequencesLeft, TReverseInfix(buffers.infixLeftH));
+        appendValue(sequencesLeft, TReverseInfix(buffers.infixLeftV));
 
-        // put infix segments
-        appendValue(sequencesLeft, infix(sequenceCopyLeftH, 0, length(sequenceCopyLeftH)));
-        appendValue(sequencesLeft, infix(sequenceCopyLeftV, 0, length(sequenceCopyLeftV)));
-
-        _fillMatrixBestEndsLeft(matrixLeft, possibleEndsLeft, sequencesLeft, diagLowerLeft, diagUpperLeft, scoreMatrix);
+        recomputeTraceLeft = _recomputeExtensionTrace(sequencesLeft, diagLowerLeft, diagUpperLeft);
+        if (recomputeTraceLeft)
+        {
+            extension_score_only_trace scoreOnlyTrace{};
+            _fillMatrixBestEndsLeft(scoreOnlyTrace, possibleEndsLeft, sequencesLeft, diagLowerLeft, diagUpperLeft,
+                                    scoreMatrix, scoreDropOff, buffers.bandedNwBestEnds);
+        }
+        else
+        {
+            _fillMatrixBestEndsLeft(matrixLeft, possibleEndsLeft, sequencesLeft, diagLowerLeft, diagUpperLeft,
+                                    scoreMatrix, scoreDropOff, buffers.bandedNwBestEnds);
+        }
         SEQAN_ASSERT_NOT(empty(possibleEndsLeft));
         }); // measure_time
     } else appendValue(possibleEndsLeft, TEndInfo());
@@ -518,7 +571,18 @@ _bestExtension(Segment<TSequence const, InfixSegment> const & infH,
         appendValue(sequencesRight, infix(host(infH), endPositionH(seedOld), endPositionH(seed)));
         appendValue(sequencesRight, infix(host(infV), endPositionV(seedOld), endPositionV(seed)));
 
-        _fillMatrixBestEndsRight(matrixRight, possibleEndsRight, sequencesRight, diagLowerRight, diagUpperRight, scoreMatrix);
+        recomputeTraceRight = _recomputeExtensionTrace(sequencesRight, diagLowerRight, diagUpperRight);
+        if (recomputeTraceRight)
+        {
+            extension_score_only_trace scoreOnlyTrace{};
+            _fillMatrixBestEndsRight(scoreOnlyTrace, possibleEndsRight, sequencesRight, diagLowerRight, diagUpperRight,
+                                     scoreMatrix, scoreDropOff, buffers.bandedNwBestEnds);
+        }
+        else
+        {
+            _fillMatrixBestEndsRight(matrixRight, possibleEndsRight, sequencesRight, diagLowerRight, diagUpperRight,
+                                     scoreMatrix, scoreDropOff, buffers.bandedNwBestEnds);
+        }
         SEQAN_ASSERT_NOT(empty(possibleEndsRight));
         }); // measure_time
     } else appendValue(possibleEndsRight, TEndInfo());
@@ -527,7 +591,8 @@ _bestExtension(Segment<TSequence const, InfixSegment> const & infH,
     // longest eps match on poss ends string
     Pair<TEndIterator> endPair = best_extension_runtime.longest_eps_match_time.measure_time([&]()
     {
-        return longestEpsMatch(possibleEndsLeft, possibleEndsRight, alignLen, alignErr, minLength, eps);
+        return longestEpsMatch(possibleEndsLeft, possibleEndsRight, alignLen, alignErr, minLength, eps,
+                               buffers.longestEpsMatch);
     });
 
     if (endPair == Pair<TEndIterator>(0, 0)) { // no eps-match found
@@ -571,6 +636,17 @@ _bestExtension(Segment<TSequence const, InfixSegment> const & infH,
         assert(direction == EXTEND_BOTH || direction == EXTEND_LEFT);
         auto const infixAlignHBeginPosition = beginPositionH(seed) + length(sequencesLeft[0]) - endLeftH;
         auto const infixAlignVBeginPosition = beginPositionV(seed) + length(sequencesLeft[1]) - endLeftV;
+        if (recomputeTraceLeft)
+        {
+            // the rows of the left extension end at the begin of the eps-match, buffers.infixLeftH is unchanged
+            buffers.infixLeftV = infix(host(infV), beginPositionV(seedOld) - endLeftV, beginPositionV(seedOld));
+            clear(sequencesLeft);
+            appendValue(sequencesLeft, TReverseInfix(buffers.infixLeftH));
+            appendValue(sequencesLeft, TReverseInfix(buffers.infixLeftV));
+
+            _fillMatrixBestEndsLeft(matrixLeft, buffers.recomputedEnds, sequencesLeft, diagLowerLeft, diagUpperLeft,
+                                    scoreMatrix, scoreDropOff, buffers.bandedNwBestEnds);
+        }
         _tracebackLeft(matrixLeft,
                        (*endPair.i1).coord,
                        sequencesLeft,
@@ -580,12 +656,24 @@ _bestExtension(Segment<TSequence const, InfixSegment> const & infH,
                        diagUpperLeft,
                        endLeftH,
                        endLeftV,
-                       align);
+                       align,
+                       buffers.traceBack,
+                       buffers.infixAlign);
     }
     if((*endPair.i2).length != 0) { // ... extension to the right
         assert(direction == EXTEND_BOTH || direction == EXTEND_RIGHT);
         auto const infixAlignHBeginPosition = endPositionH(seedOld);
         auto const infixAlignVBeginPosition = endPositionV(seedOld);
+        if (recomputeTraceRight)
+        {
+            // the rows of the right extension end at the end of the eps-match
+            clear(sequencesRight);
+            appendValue(sequencesRight, infix(host(infH), endPositionH(seedOld), endPositionH(seed)));
+            appendValue(sequencesRight, infix(host(infV), endPositionV(seedOld), endPositionV(seedOld) + endRightV));
+
+            _fillMatrixBestEndsRight(matrixRight, buffers.recomputedEnds, sequencesRight, diagLowerRight, diagUpperRight,
+                                     scoreMatrix, scoreDropOff, buffers.bandedNwBestEnds);
+        }
         _tracebackRight(matrixRight,
                         (*endPair.i2).coord,
                         sequencesRight,
@@ -595,7 +683,9 @@ _bestExtension(Segment<TSequence const, InfixSegment> const & infH,
                         diagUpperRight,
                         endRightH,
                         endRightV,
-                        align);
+                        align,
+                        buffers.traceBack,
+                        buffers.infixAlign);
     }
     SEQAN_ASSERT_EQ(length(row(align, 0)), length(row(align, 1)));
     }); // measure_time
@@ -639,6 +729,7 @@ _extendAndExtract(Align<Segment<Segment<TSequence const, InfixSegment>, InfixSeg
                   TSize const minLength,
                   TEps const eps,
                   TAlign & align,
+                  StellarExtensionBuffers<TSequence> & buffers,
                   stellar_extension_time & extension_runtime) {
     typedef typename Position<TSequence>::Type TPos;
     typedef Seed<Simple> TSeed;
@@ -668,7 +759,7 @@ _extendAndExtract(Align<Segment<Segment<TSequence const, InfixSegment>, InfixSeg
         if ((TSize)length(row(align, 0)) < minLength)
             return false;
 
-        longestEpsMatch(align, minLength, eps);
+        longestEpsMatch(align, minLength, eps, buffers.epsMatchGaps);
     } else {
         // gapped X-drop extension of local alignment (seed)
         TSeed seed(seedBeginH, seedBeginV, seedEndH, seedEndV);
@@ -711,7 +802,8 @@ _extendAndExtract(Align<Segment<Segment<TSequence const, InfixSegment>, InfixSeg
 
         bool const found_extension = extension_runtime.best_extension_time.measure_time([&]()
         {
-            return _bestExtension(infixH, infixV, seed, seedOld, alignLen, alignErr, scoreMatrix, direction, minLength, eps, align, extension_runtime.best_extension_time);
+            return _bestExtension(infixH, infixV, seed, seedOld, alignLen, alignErr, scoreMatrix,
+                                  (typename Value<TScore>::Type)scoreDropOff, direction, minLength, eps, align, buffers, extension_runtime.best_extension_time);
         });
         if (!found_extension)
             return false;
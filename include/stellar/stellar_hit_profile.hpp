@@ -0,0 +1,123 @@
+
+#pragma once
+
+#include <algorithm>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+#include <stellar/database_id_map.hpp>
+#include <stellar/query_id_map.hpp>
+#include <stellar/stellar_database_segment.hpp>
+#include <stellar/stellar_query_segment.hpp>
+#include <stellar/utils/stellar_runtime.hpp>
+
+namespace stellar
+{
+
+///////////////////////////////////////////////////////////////////////////////
+// Optional counters of the SWIFT hits of one stellar run.
+// Counts the SWIFT hits and the verification time per query and the SWIFT hits per SWIFT bucket. A SWIFT bucket is
+// identified by its query, database, database strand, and the diagonal range of width bucketWidth it counts q-gram
+// hits for.
+template <typename TAlphabet, typename TId = CharString>
+struct StellarHitProfile
+{
+    struct QueryCounters
+    {
+        size_t numSwiftHits{0u};
+        size_t numVerifiedSwiftHits{0u};
+        stellar_runtime verificationTime{};
+    };
+
+    struct Bucket
+    {
+        size_t queryRecordID;
+        size_t databaseRecordID;
+        bool databaseStrand;
+        int64_t diagonalBucket;
+
+        friend bool operator==(Bucket const & b1, Bucket const & b2)
+        {
+            return b1.queryRecordID == b2.queryRecordID && b1.databaseRecordID == b2.databaseRecordID &&
+                   b1.databaseStrand == b2.databaseStrand && b1.diagonalBucket == b2.diagonalBucket;
+        }
+    };
+
+    struct BucketHash
+    {
+        size_t operator()(Bucket const & bucket) const
+        {
+            size_t hash = std::hash<int64_t>{}(bucket.diagonalBucket);
+            hash = hash * 31u + bucket.queryRecordID;
+            hash = hash * 31u + bucket.databaseRecordID;
+            return hash * 2u + bucket.databaseStrand;
+        }
+    };
+
+    StellarHitProfile(StringSet<String<TAlphabet>> const & databases,
+                      StringSet<TId> const & databaseIDs,
+                      StringSet<String<TAlphabet>> const & queries,
+                      unsigned const bucketWidth)
+        : databaseIDMap{databases, databaseIDs}, queryIDMap{queries}, bucketWidth{bucketWidth},
+          queryCounters(length(queries))
+    {}
+
+    // Records a SWIFT hit, verificationTime is zero if the hit was not verified (e.g. because the query is disabled).
+    void addSwiftHit(StellarDatabaseSegment<TAlphabet> const & databaseSegment,
+                     StellarQuerySegment<TAlphabet> const & querySegment,
+                     bool const databaseStrand,
+                     bool const verified,
+                     stellar_runtime::duration_t const verificationTime)
+    {
+        size_t const queryRecordID = queryIDMap.recordID(querySegment.underlyingQuery());
+
+        QueryCounters & counters = queryCounters[queryRecordID];
+        ++counters.numSwiftHits;
+        counters.numVerifiedSwiftHits += verified;
+        counters.verificationTime.manual_timing(verificationTime);
+
+        int64_t const diagonal = static_cast<int64_t>(databaseSegment.beginPosition())
+                               - static_cast<int64_t>(querySegment.beginPosition());
+        int64_t const width = static_cast<int64_t>(bucketWidth);
+        // round towards negative infinity
+        int64_t const diagonalBucket = (diagonal >= 0) ? diagonal / width : -((-diagonal + width - 1) / width);
+
+        Bucket const bucket
+        {
+            STELLAR_DESIGNATED_INITIALIZER(.queryRecordID =, queryRecordID),
+            STELLAR_DESIGNATED_INITIALIZER(.databaseRecordID =, databaseIDMap.recordID(databaseSegment)),
+            STELLAR_DESIGNATED_INITIALIZER(.databaseStrand =, databaseStrand),
+            STELLAR_DESIGNATED_INITIALIZER(.diagonalBucket =, diagonalBucket)
+        };
+        ++bucketHits[bucket];
+    }
+
+    // Returns the topN buckets with the most SWIFT hits in descending order.
+    std::vector<std::pair<Bucket, size_t>> hottestBuckets(size_t const topN) const
+    {
+        std::vector<std::pair<Bucket, size_t>> buckets(bucketHits.begin(), bucketHits.end());
+        auto moreHits = [](auto const & b1, auto const & b2)
+        {
+            if (b1.second != b2.second)
+                return b1.second > b2.second;
+            // make order independent of the hash map
+            return std::tie(b1.first.queryRecordID, b1.first.databaseRecordID, b1.first.databaseStrand, b1.first.diagonalBucket)
+                 < std::tie(b2.first.queryRecordID, b2.first.databaseRecordID, b2.first.databaseStrand, b2.first.diagonalBucket);
+        };
+
+        size_t const count = std::min(topN, buckets.size());
+        std::partial_sort(buckets.begin(), buckets.begin() + count, buckets.end(), moreHits);
+        buckets.resize(count);
+        return buckets;
+    }
+
+    DatabaseIDMap<TAlphabet, TId> databaseIDMap;
+    QueryIDMap<TAlphabet, TId> queryIDMap;
+    unsigned bucketWidth;
+
+    std::vector<QueryCounters> queryCounters; // one per query
+    std::unordered_map<Bucket, size_t, BucketHash> bucketHits{};
+};
+
+} // namespace stellar
@@ -24,9 +24,19 @@
 #ifndef SEQAN_HEADER_STELLAR_OUTPUT_H
 #define SEQAN_HEADER_STELLAR_OUTPUT_H
 
+#include <algorithm>
+#include <charconv>
 #include <iostream>
+#include <span>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
 #include <seqan/align.h>
 
+#include <stellar/stellar_hit_profile.hpp>
 #include <stellar/stellar_types.hpp> // QueryMatches
 
 namespace stellar
@@ -112,103 +122,91 @@ _computeLengthAdjustment(TSize const dbLength, TSize const queryLength) {
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-// Computes a CIGAR string and mutations from rows of StellarMatch.
-template<typename TRow, typename TString>
+// Computes a CIGAR string and mutations from the edit script of a StellarMatch.
+// Reference implementation for the tests and benchmarks of StellarGffFormatter, the output uses the formatter.
+template<typename TMatch, typename TString>
 void
-_getCigarLine(TRow const & row0, TRow const & row1, TString & cigar, TString & mutations) {
-    typedef typename Size<TRow>::Type TSize;
-
-    TSize pos = 0;
+_getCigarLine(TMatch const & match, String<StellarEditRun> const & editScripts, TString & cigar, TString & mutations) {
+    typedef typename TMatch::TPos TPos;
 
-    SEQAN_ASSERT_EQ(length(row0), length(row1));
-    TSize dbEndPos = length(row0);
-    TSize queryEndPos = length(row1);
+    auto const & database = *match.database;
+    auto const & query = *match.query;
 
     bool first = true;
-    TSize readBasePos = pos + clippedBeginPosition(row1);
-    TSize readPos = 0;
-    while (pos < dbEndPos || pos < queryEndPos) {
-        int matched = 0;
-        int inserted = 0;
-        int deleted = 0;
-        while (pos != dbEndPos && pos != queryEndPos &&
-               !isGap(row0, pos) && !isGap(row1, pos)) {
-            ++readPos;
-            if (value(row0, pos) != value(row1, pos)) {
+    TPos dbPos = match.begin1;
+    TPos readBasePos = match.begin2;
+    TPos readPos = 0;
+    for (StellarEditRun const editRun : _editScript(match, editScripts)) {
+        if (editRun.kind == StellarEditRun::aligned) {
+            for (uint32_t i = 0; i < editRun.count; ++i) {
+                ++readPos;
+                if (database[dbPos] != query[readBasePos]) {
+                    if (first) first = false;
+                    else mutations << ",";
+                    mutations << readPos << query[readBasePos];
+                }
+                ++readBasePos;
+                ++dbPos;
+            }
+            cigar << editRun.count << "M";
+        } else if (editRun.kind == StellarEditRun::deletion) {
+            dbPos += editRun.count;
+            cigar << editRun.count << "D";
+        } else {
+            for (uint32_t i = 0; i < editRun.count; ++i) {
+                ++readPos;
                 if (first) first = false;
                 else mutations << ",";
-                mutations << readPos << value(source(row1), readBasePos);
+                mutations << readPos << query[readBasePos];
+                ++readBasePos;
             }
-            ++readBasePos;
-            ++pos;
-            ++matched;
+            cigar << editRun.count << "I";
         }
-        if (matched > 0) cigar << matched << "M" ;
-        while (pos < dbEndPos && isGap(row1, pos)) {
-            ++pos;
-            ++deleted;
-        }
-        if (deleted > 0) cigar << deleted << "D";
-        while (pos < queryEndPos && isGap(row0, pos)) {
-            ++pos;
-            ++readPos;
-            if (first) first = false;
-            else mutations << ",";
-            mutations << readPos << value(source(row1), readBasePos);
-            ++readBasePos;
-            ++inserted;
-        }
-        if (inserted > 0) cigar << inserted << "I";
     }
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-// Determines the length and the number of matches of two alignment rows
-template<typename TRow, typename TSize>
+// Determines the length and the number of matches of a StellarMatch
+// The matches are counted by _countMatchingColumns when the StellarMatch is stored, see _insertMatch.
+template<typename TMatch, typename TSize>
 inline void
-_analyzeAlignment(TRow const & row0, TRow const & row1, TSize & aliLen, TSize & matches) {
-    TSize pos = 0;
-    SEQAN_ASSERT_EQ(length(row0), length(row1));
-    TSize end0 = length(row0);
-    TSize end1 = length(row1);
-
-    matches = 0;
-    while ((pos < end0) && (pos < end1)) {
-        if (!isGap(row0, pos) && !isGap(row1, pos)) {
-            if (value(row0, pos) == value(row1, pos)) {
-                ++matches;
-            }
-        }
-        ++pos;
-    }
+_analyzeAlignment(TMatch const & match, TSize & aliLen, TSize & matches) {
+    matches = match.matchingColumns;
+    aliLen = length(match);
+}
 
-    aliLen = _max(end0, end1);
+///////////////////////////////////////////////////////////////////////////////
+// Calculates the identity of an alignment (percentage of matching positions).
+template<typename TSize>
+inline double
+_identity(TSize const aliLen, TSize const matches) {
+    return floor(1000000.0 * matches / aliLen) / 10000.0;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-// Calculates the identity of two alignment rows (percentage of matching positions).
-template<typename TRow>
+// Calculates the identity of a StellarMatch (percentage of matching positions).
+// Reference implementation for the tests and benchmarks of StellarGffFormatter, the output uses _gffRecord.
+template<typename TMatch>
 double
-_computeIdentity(TRow const & row0, TRow const & row1) {
-    typedef typename Size<TRow>::Type TSize;
+_computeIdentity(TMatch const & match) {
+    typedef typename TMatch::TPos TSize;
     TSize matches, aliLen;
-    _analyzeAlignment(row0, row1, aliLen, matches);
+    _analyzeAlignment(match, aliLen, matches);
 
-    return floor(1000000.0 * matches / aliLen) / 10000.0;
+    return _identity(aliLen, matches);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-// Calculates the E-value from two alignment rows and a specified length adjustment
-template<typename TRow, typename TSize>
+// Calculates the E-value of a StellarMatch with the given length and number of matches, and a specified length
+//  adjustment
+template<typename TMatch, typename TSize>
 double
-_computeEValue(TRow const & row0, TRow const & row1, TSize const lengthAdjustment) {
-    TSize m = length(source(row0)) - lengthAdjustment;
-    TSize n = length(source(row1)) - lengthAdjustment;
+_matchEValue(TMatch const & match, TSize const aliLen, TSize const matches, TSize const lengthAdjustment) {
+    TSize m = length(*match.database) - lengthAdjustment;
+    TSize n = length(*match.query) - lengthAdjustment;
     double minusLambda = -1.19; // -lambda
     double K = 0.34;
 
-    TSize matches, aliLen;
-    _analyzeAlignment(row0, row1, aliLen, matches);
     // score = 1 * matches - 2 * errors (mismatches or gaps)
     //       = matches - 2 * (aliLen - matches)
     TSize score = matches - 2 * (aliLen - matches);
@@ -216,6 +214,16 @@ _computeEValue(TRow const & row0, TRow const & row1, TSize const lengthAdjustmen
     return K * (double)m * (double)n * exp(minusLambda * (double)score);
 }
 
+///////////////////////////////////////////////////////////////////////////////
+// Calculates the E-value of a StellarMatch and a specified length adjustment
+template<typename TMatch, typename TSize>
+double
+_computeEValue(TMatch const & match, TSize const lengthAdjustment) {
+    TSize matches, aliLen;
+    _analyzeAlignment(match, aliLen, matches);
+    return _matchEValue(match, aliLen, matches, lengthAdjustment);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // Calculates the E-value for an alignment with the specified score and number
 //  of matches, and the specified length of query and database sequence
@@ -233,18 +241,20 @@ _computeEValue(TSize const score, TSize const len0, TSize const len1) {
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-// Writes rows of a StellarMatch in gff format to a file.
-template<typename TId, typename TSize, typename TRow, typename TFile>
+// Writes a StellarMatch in gff format to a file.
+// Reference implementation for the tests and benchmarks of StellarGffFormatter, which writes the same bytes and is
+//  used for the output.
+template<typename TId, typename TSize, typename TMatch, typename TFile>
 void
 _writeMatchGff(TId const & databaseID,
               TId const & patternID,
               bool const databaseStrand,
               TSize const lengthAdjustment,
-              TRow const & row0,
-              TRow const & row1,
+              TMatch const & match,
+              String<StellarEditRun> const & editScripts,
               TFile & file) {
 //IOREV _recordreading_ unclear how this is related to GFF support from store_io
-    typedef typename Value<typename Source<TRow>::Type>::Type TAlphabet;
+    typedef typename Value<typename TMatch::TSequence>::Type TAlphabet;
 
     for (typename Position<TId>::Type i = 0; i < length(databaseID) && value(databaseID, i) > 32; ++i) {
         file << value(databaseID, i);
@@ -254,14 +264,14 @@ _writeMatchGff(TId const & databaseID,
     file << "\teps-matches";
 
     if (databaseStrand) {
-        file << "\t" << beginPosition(row0) + beginPosition(source(row0)) + 1;
-        file << "\t" << endPosition(row0) + beginPosition(source(row0));
+        file << "\t" << match.begin1 + 1;
+        file << "\t" << match.end1;
     } else {
-        file << "\t" << length(source(row0)) - (endPosition(row0) + beginPosition(source(row0))) + 1;
-        file << "\t" << length(source(row0)) - (beginPosition(row0) + beginPosition(source(row0)));
+        file << "\t" << length(*match.database) - match.end1 + 1;
+        file << "\t" << length(*match.database) - match.begin1;
     }
 
-    file << "\t" << _computeIdentity(row0, row1);
+    file << "\t" << _computeIdentity(match);
 
     file << "\t" << (databaseStrand ? '+' : '-');
 
@@ -270,34 +280,254 @@ _writeMatchGff(TId const & databaseID,
         file << value(patternID, i);
     }
 
-    //file << ";seq2Length=" << length(source(row1));
+    //file << ";seq2Length=" << length(*match.query);
 
-    file << ";seq2Range=" << beginPosition(row1) + beginPosition(source(row1)) + 1;
-    file << "," << endPosition(row1) + beginPosition(source(row1));
+    file << ";seq2Range=" << match.begin2 + 1;
+    file << "," << match.end2;
 
     if (IsSameType<TAlphabet, Dna5>::VALUE || IsSameType<TAlphabet, Rna5>::VALUE)
-        file << ";eValue=" << _computeEValue(row0, row1, lengthAdjustment);
+        file << ";eValue=" << _computeEValue(match, lengthAdjustment);
 
     std::stringstream cigar, mutations;
-    _getCigarLine(row0, row1, cigar, mutations);
+    _getCigarLine(match, editScripts, cigar, mutations);
     file << ";cigar=" << cigar.str();
     file << ";mutations=" << mutations.str();
     file << "\n";
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-// Writes rows of a StellarMatch in human readable format to file.
-template<typename TId, typename TSize, typename TRow, typename TFile>
+// Returns the id up to the first whitespace character, as written in the gff output.
+template <typename TId>
+inline std::string_view
+_shortIdView(TId const & id) {
+    auto const idBegin = begin(id, Standard());
+    size_t idLength = 0;
+    while (idLength < length(id) && idBegin[idLength] > 32)
+        ++idLength;
+    return std::string_view{idBegin, idLength};
+}
+
+template <typename TId>
+inline std::vector<std::string_view>
+_shortIdViews(StringSet<TId> const & ids) {
+    std::vector<std::string_view> shortIds{};
+    shortIds.reserve(length(ids));
+    for (TId const & id : ids)
+        shortIds.push_back(_shortIdView(id));
+    return shortIds;
+}
+
+// appends the decimal number (a double like std::ostream, i.e. like printf("%g"))
+template <typename TNumber>
+inline void
+_appendChars(std::string & buffer, TNumber const number) {
+    char chars[32];
+    std::to_chars_result const result = std::to_chars(chars, chars + sizeof(chars), number);
+    buffer.append(chars, result.ptr);
+}
+
+inline void
+_appendChars(std::string & buffer, double const number) {
+    char chars[32];
+    std::to_chars_result const result = std::to_chars(chars, chars + sizeof(chars), number,
+                                                      std::chars_format::general, 6);
+    buffer.append(chars, result.ptr);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// A base of the query that differs from the database, at readPosition (counted from 1) of a match.
+struct StellarMutation
+{
+    uint32_t readPosition;
+    char base;
+    char padding[3];
+};
+
+///////////////////////////////////////////////////////////////////////////////
+// Appends the mutations of a StellarMatch, i.e. the mismatching and the inserted query bases, to mutations.
+template <typename TMatch, typename TMutations>
+void
+_appendMutations(TMatch const & match, String<StellarEditRun> const & editScripts, TMutations & mutations) {
+    typedef typename TMatch::TPos TPos;
+
+    auto const & database = *match.database;
+    auto const & query = *match.query;
+
+    TPos dbPos = match.begin1;
+    TPos readBasePos = match.begin2;
+    uint32_t readPos = 0;
+    for (StellarEditRun const editRun : _editScript(match, editScripts)) {
+        if (editRun.kind == StellarEditRun::aligned) {
+            for (uint32_t i = 0; i < editRun.count; ++i, ++readBasePos, ++dbPos) {
+                ++readPos;
+                if (database[dbPos] != query[readBasePos])
+                    mutations.push_back({readPos, convert<char>(query[readBasePos]), {}});
+            }
+        } else if (editRun.kind == StellarEditRun::deletion) {
+            dbPos += editRun.count;
+        } else {
+            for (uint32_t i = 0; i < editRun.count; ++i, ++readBasePos)
+                mutations.push_back({++readPos, convert<char>(query[readBasePos]), {}});
+        }
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// The fields of a gff line of a match. Database positions are on the forward strand, i.e. the gff positions are
+// databaseBegin + 1 and databaseEnd.
+struct StellarGffRecord
+{
+    std::string_view databaseID{};
+    std::string_view queryID{};
+    uint64_t databaseBegin{};
+    uint64_t databaseEnd{};
+    uint64_t queryBegin{};
+    uint64_t queryEnd{};
+    double identity{};
+    double eValue{};
+    bool databaseStrand{};
+    bool hasEValue{}; // the alphabet is Dna5 or Rna5
+};
+
+///////////////////////////////////////////////////////////////////////////////
+// Returns the gff fields of a StellarMatch, the ids are left empty.
+template <typename TSize, typename TMatch>
+StellarGffRecord
+_gffRecord(TMatch const & match, TSize const lengthAdjustment) {
+    typedef typename Value<typename TMatch::TSequence>::Type TAlphabet;
+    typedef typename TMatch::TPos TPos;
+
+    uint64_t const databaseLength = length(*match.database);
+
+    StellarGffRecord record{};
+    record.databaseStrand = match.orientation;
+    record.databaseBegin = match.orientation ? match.begin1 : databaseLength - match.end1;
+    record.databaseEnd = match.orientation ? match.end1 : databaseLength - match.begin1;
+    record.queryBegin = match.begin2;
+    record.queryEnd = match.end2;
+    record.identity = _identity<TPos>(length(match), match.matchingColumns);
+    record.hasEValue = IsSameType<TAlphabet, Dna5>::VALUE || IsSameType<TAlphabet, Rna5>::VALUE;
+    if (record.hasEValue)
+        record.eValue = _matchEValue(match, (TSize)length(match), (TSize)match.matchingColumns, lengthAdjustment);
+    return record;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Formats matches in gff format into a char buffer, byte-identical to _writeMatchGff.
+// appendRecord formats a line from plain fields, it is used for StellarMatches and for the matches of binary match
+//  files. Numbers are converted with std::to_chars and the ids are precomputed views of the short ids. The
+//  mutations buffer is reused for all matches.
+struct StellarGffFormatter
+{
+    std::span<std::string_view const> databaseIDs; // short database ids by record id, see _shortIdViews
+
+    explicit StellarGffFormatter(std::span<std::string_view const> const shortDatabaseIDs) :
+        databaseIDs{shortDatabaseIDs}
+    {}
+
+    // editRuns is a range of StellarEditRun
+    template <typename TEditRuns>
+    static void appendRecord(std::string & buffer,
+                             StellarGffRecord const & record,
+                             TEditRuns const & editRuns,
+                             std::span<StellarMutation const> const mutations)
+    {
+        buffer.append(record.databaseID);
+        buffer.append("\tStellar\teps-matches\t");
+        _appendChars(buffer, record.databaseBegin + 1);
+        buffer.push_back('\t');
+        _appendChars(buffer, record.databaseEnd);
+        buffer.push_back('\t');
+        _appendChars(buffer, record.identity);
+        buffer.append(record.databaseStrand ? "\t+" : "\t-");
+        buffer.append("\t.\t");
+        buffer.append(record.queryID);
+
+        buffer.append(";seq2Range=");
+        _appendChars(buffer, record.queryBegin + 1);
+        buffer.push_back(',');
+        _appendChars(buffer, record.queryEnd);
+
+        if (record.hasEValue) {
+            buffer.append(";eValue=");
+            _appendChars(buffer, record.eValue);
+        }
+
+        buffer.append(";cigar=");
+        for (StellarEditRun const editRun : editRuns) {
+            _appendChars(buffer, editRun.count);
+            buffer.push_back(editRun.kind == StellarEditRun::aligned ? 'M' :
+                             editRun.kind == StellarEditRun::deletion ? 'D' : 'I');
+        }
+
+        buffer.append(";mutations=");
+        for (size_t i = 0; i < mutations.size(); ++i) {
+            if (i != 0)
+                buffer.push_back(',');
+            _appendChars(buffer, mutations[i].readPosition);
+            buffer.push_back(mutations[i].base);
+        }
+        buffer.push_back('\n');
+    }
+
+    template <typename TSize, typename TMatch>
+    void appendMatch(std::string & buffer,
+                     std::string_view const patternID,
+                     TSize const lengthAdjustment,
+                     TMatch const & match,
+                     String<StellarEditRun> const & editScripts)
+    {
+        StellarGffRecord record = _gffRecord(match, lengthAdjustment);
+        record.databaseID = databaseIDs[match.databaseRecordID];
+        record.queryID = patternID;
+
+        mutations.clear();
+        _appendMutations(match, editScripts, mutations);
+        appendRecord(buffer, record, _editScript(match, editScripts), mutations);
+    }
+
+private:
+    std::vector<StellarMutation> mutations{};
+};
+
+///////////////////////////////////////////////////////////////////////////////
+// Builds the alignment rows of a StellarMatch from its edit script.
+template<typename TMatch>
+void
+_matchAlignment(TMatch const & match,
+                String<StellarEditRun> const & editScripts,
+                typename TMatch::TAlign & align) {
+    resize(rows(align), 2);
+    setSource(row(align, 0), *match.database);
+    setSource(row(align, 1), *match.query);
+    setBeginPosition(row(align, 0), match.begin1);
+    setEndPosition(row(align, 0), match.end1);
+    setBeginPosition(row(align, 1), match.begin2);
+    setEndPosition(row(align, 1), match.end2);
+
+    typename TMatch::TPos viewPos = 0;
+    for (StellarEditRun const editRun : _editScript(match, editScripts)) {
+        if (editRun.kind == StellarEditRun::insertion)
+            insertGaps(row(align, 0), viewPos, editRun.count);
+        else if (editRun.kind == StellarEditRun::deletion)
+            insertGaps(row(align, 1), viewPos, editRun.count);
+        viewPos += editRun.count;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Writes a StellarMatch in human readable format to file.
+template<typename TId, typename TSize, typename TMatch, typename TFile>
 void
 _writeMatch(TId const & databaseID,
             TId const & patternID,
             bool const databaseStrand,
             TSize const lengthAdjustment,
-            TRow const & row0,
-            TRow const & row1,
+            TMatch const & match,
+            String<StellarEditRun> const & editScripts,
             TFile & file) {
 //IOREV _recordreading_ _stub_
-    typedef typename Value<typename Source<TRow>::Type>::Type TAlphabet;
+    typedef typename Value<typename TMatch::TSequence>::Type TAlphabet;
 
     // write database ID
     file << "Database sequence: " << databaseID;
@@ -307,11 +537,11 @@ _writeMatch(TId const & databaseID,
     // write database positions
     file << "Database positions: ";
     if (databaseStrand) {
-        file << beginPosition(row0) + beginPosition(source(row0));
-        file << ".." << endPosition(row0) + beginPosition(source(row0));
+        file << match.begin1;
+        file << ".." << match.end1;
     } else {
-        file << length(source(row0)) - beginPosition(row0) + beginPosition(source(row0));
-        file << ".." << length(source(row0)) - endPosition(row0) + beginPosition(source(row0));
+        file << length(*match.database) - match.begin1;
+        file << ".." << length(*match.database) - match.end1;
     }
     file << std::endl;
 
@@ -320,77 +550,124 @@ _writeMatch(TId const & databaseID,
 
     // write query positions
     file << "Query positions: ";
-    file << beginPosition(row1) + beginPosition(source(row1));
-    file << ".." << endPosition(row1) + beginPosition(source(row1));
+    file << match.begin2;
+    file << ".." << match.end2;
     file << std::endl;
 
     if (IsSameType<TAlphabet, Dna5>::VALUE || IsSameType<TAlphabet, Rna5>::VALUE)
     {
         // write e-value
-        file << "E-value: " << _computeEValue(row0, row1, lengthAdjustment) << std::endl;
+        file << "E-value: " << _computeEValue(match, lengthAdjustment) << std::endl;
     }
 
     file << std::endl;
 
     // write match
-    Align<typename Source<TRow>::Type> align;
-    appendValue(align.data_rows, row0);
-    appendValue(align.data_rows, row1);
+    typename TMatch::TAlign align;
+    _matchAlignment(match, editScripts, align);
     file << align;
     file << "----------------------------------------------------------------------\n" << std::endl;
 }
 
 template <typename TInfix, typename TQueryId>
-void _writeMatchesToGffFile(QueryMatches<StellarMatch<TInfix const, TQueryId> > const & queryMatches,
-                            CharString const & id, bool const orientation, std::ofstream & outputFile)
+void _appendMatchesToGffBuffer(QueryMatches<StellarMatch<TInfix const, TQueryId> > const & queryMatches,
+                               StellarGffFormatter & formatter,
+                               std::string_view const id, bool const orientation, std::string & buffer)
 {
     for (StellarMatch<TInfix const, TQueryId> const & match : queryMatches.matches) {
         if (match.orientation != orientation)
             continue;
 
-        _writeMatchGff(match.id, id, match.orientation, queryMatches.lengthAdjustment,
-                       match.row1, match.row2, outputFile);
+        formatter.appendMatch(buffer, id, queryMatches.lengthAdjustment, match, queryMatches.editScripts);
     }
 }
 
+template <typename TInfix, typename TQueryId>
+void _writeMatchesToGffFile(QueryMatches<StellarMatch<TInfix const, TQueryId> > const & queryMatches,
+                            StringSet<TQueryId> const & databaseIDs,
+                            CharString const & id, bool const orientation, std::ostream & outputFile)
+{
+    std::vector<std::string_view> const shortDatabaseIDs = _shortIdViews(databaseIDs);
+    StellarGffFormatter formatter{shortDatabaseIDs};
+
+    std::string buffer;
+    _appendMatchesToGffBuffer(queryMatches, formatter, _shortIdView(id), orientation, buffer);
+    outputFile.write(buffer.data(), buffer.size());
+}
+
 template <typename TInfix, typename TQueryId>
 void _writeMatchesToTxtFile(QueryMatches<StellarMatch<TInfix const, TQueryId> > const &queryMatches,
-                            CharString const & id, bool const orientation, std::ofstream & outputFile)
+                            StringSet<TQueryId> const & databaseIDs,
+                            CharString const & id, bool const orientation, std::ostream & outputFile)
 {
     for (StellarMatch<TInfix const, TQueryId> const & match : queryMatches.matches) {
         if (match.orientation != orientation)
             continue;
 
-        _writeMatch(match.id, id, match.orientation, queryMatches.lengthAdjustment,
-                    match.row1, match.row2, outputFile);
+        _writeMatch(databaseIDs[match.databaseRecordID], id, match.orientation, queryMatches.lengthAdjustment,
+                    match, queryMatches.editScripts, outputFile);
     }
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-// Calls _writeMatchGff for each match in String of matches.
-//   = Writes matches in gff format to a file.
+// Writes the matches of one orientation in gff (with StellarGffFormatter) or in human readable format to a file.
 template <typename TInfix, typename TQueryId>
 void _writeQueryMatchesToFile(QueryMatches<StellarMatch<TInfix const, TQueryId> > const & queryMatches,
-                              CharString const & id, bool const orientation, CharString const & outputFormat, std::ofstream & outputFile)
+                              StringSet<TQueryId> const & databaseIDs,
+                              CharString const & id, bool const orientation, CharString const & outputFormat, std::ostream & outputFile)
 {
     if (outputFormat == "gff")
-        _writeMatchesToGffFile(queryMatches, id, orientation, outputFile);
+        _writeMatchesToGffFile(queryMatches, databaseIDs, id, orientation, outputFile);
     else
-        _writeMatchesToTxtFile(queryMatches, id, orientation, outputFile);
+        _writeMatchesToTxtFile(queryMatches, databaseIDs, id, orientation, outputFile);
 }
 
+// number of queries whose matches are formatted in parallel before they are written
+constexpr size_t _outputQueryBatchSize = 1024u;
+
 ///////////////////////////////////////////////////////////////////////////////
-// Calls _writeMatchGff for each match in StringSet of String of matches.
-//   = Writes matches in gff format to a file.
+// Writes the matches of one orientation of all queries in gff or in human readable format to a file.
+// The matches of a batch of queries are formatted in parallel into one buffer per query, the buffers are written in
+//   query order. The output is the same as if the matches were written one after another. Each thread reuses one
+//   StellarGffFormatter for all of its queries.
 template <typename TInfix, typename TQueryId, typename TQueryIDs>
 void _writeAllQueryMatchesToFile(StringSet<QueryMatches<StellarMatch<TInfix const, TQueryId> > > const & matches,
+                                 StringSet<TQueryId> const & databaseIDs,
                                  TQueryIDs const & queryIDs, bool const orientation,
-                                 CharString const & outputFormat, std::ofstream & outputFile)
+                                 CharString const & outputFormat, std::ostream & outputFile)
 {
-    for (size_t i = 0; i < length(matches); i++) {
-        QueryMatches<StellarMatch<TInfix const, TQueryId>> const & queryMatches = value(matches, i);
+    size_t const queryCount = length(matches);
+    std::vector<std::string> queryBuffers(std::min(queryCount, _outputQueryBatchSize));
+    std::vector<std::string_view> const shortDatabaseIDs = _shortIdViews(databaseIDs);
+    bool const gffFormat = outputFormat == "gff";
+
+    for (size_t batchBegin = 0; batchBegin < queryCount; batchBegin += _outputQueryBatchSize) {
+        size_t const batchSize = std::min(queryCount - batchBegin, _outputQueryBatchSize);
+
+        #pragma omp parallel
+        {
+            StellarGffFormatter formatter{shortDatabaseIDs};
+
+            #pragma omp for schedule(dynamic, 1)
+            for (size_t j = 0; j < batchSize; ++j) {
+                size_t const i = batchBegin + j;
+                QueryMatches<StellarMatch<TInfix const, TQueryId>> const & queryMatches = value(matches, i);
+
+                if (gffFormat) {
+                    queryBuffers[j].clear();
+                    _appendMatchesToGffBuffer(queryMatches, formatter, _shortIdView(queryIDs[i]), orientation,
+                                              queryBuffers[j]);
+                } else {
+                    std::ostringstream queryBuffer;
+                    _writeQueryMatchesToFile(queryMatches, databaseIDs, queryIDs[i], orientation, outputFormat,
+                                             queryBuffer);
+                    queryBuffers[j] = std::move(queryBuffer).str();
+                }
+            }
+        }
 
-        _writeQueryMatchesToFile(queryMatches, queryIDs[i], orientation, outputFormat, outputFile);
+        for (size_t j = 0; j < batchSize; ++j)
+            outputFile.write(queryBuffers[j].data(), queryBuffers[j].size());
     }
 }
 
@@ -406,7 +683,7 @@ StellarOutputStatistics _computeOutputStatistics(StringSet<QueryMatches<StellarM
             ++statistics.numDisabled;
 
         for (StellarMatch<TInfix const, TQueryId> const & match : queryMatches.matches) {
-            size_t len = std::max<size_t>(length(match.row1), length(match.row2));
+            size_t len = length(match);
             statistics.totalLength += len;
             statistics.maxLength = std::max<size_t>(statistics.maxLength, len);
         }
@@ -431,6 +708,58 @@ void _writeDisabledQueriesToFastaFile(std::vector<size_t> const & disabledQueryI
         _appendDisabledQueryToFastaFile(ids[queryID], queries[queryID], disabledQueriesFile);
 }
 
+///////////////////////////////////////////////////////////////////////////////
+// Writes the id up to the first whitespace character.
+template <typename TId, typename TFile>
+void _writeShortId(TId const & id, TFile & file)
+{
+    for (typename Position<TId>::Type i = 0; i < length(id) && value(id, i) > 32; ++i)
+        file << value(id, i);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Writes the SWIFT hit counters as tab separated tables to a file:
+//   1. SWIFT hits and verification time per query
+//   2. the topN SWIFT buckets with the most hits
+template <typename TAlphabet, typename TId, typename TFile>
+void _writeHitProfile(StellarHitProfile<TAlphabet, TId> const & hitProfile,
+                      StringSet<TId> const & queryIDs,
+                      StringSet<TId> const & databaseIDs,
+                      size_t const topN,
+                      TFile & file)
+{
+    file << "#query\tswiftHits\tverifiedSwiftHits\tverificationTime(us)\n";
+    for (size_t queryRecordID = 0; queryRecordID < hitProfile.queryCounters.size(); ++queryRecordID)
+    {
+        auto const & counters = hitProfile.queryCounters[queryRecordID];
+        if (counters.numSwiftHits == 0u)
+            continue;
+
+        _writeShortId(queryIDs[queryRecordID], file);
+        file << '\t' << counters.numSwiftHits
+             << '\t' << counters.numVerifiedSwiftHits
+             << '\t' << std::chrono::duration_cast<std::chrono::microseconds>(counters.verificationTime._runtime).count()
+             << '\n';
+    }
+
+    file << "\n#query\tdatabase\tstrand\tdiagonalBegin\tdiagonalEnd\tswiftHits\n";
+    int64_t const bucketWidth = hitProfile.bucketWidth;
+    for (auto const & [bucket, numSwiftHits] : hitProfile.hottestBuckets(topN))
+    {
+        _writeShortId(queryIDs[bucket.queryRecordID], file);
+        file << '\t';
+        _writeShortId(databaseIDs[bucket.databaseRecordID], file);
+        file << '\t' << (bucket.databaseStrand ? '+' : '-')
+             << '\t' << bucket.diagonalBucket * bucketWidth
+             << '\t' << (bucket.diagonalBucket + 1) * bucketWidth
+             << '\t' << numSwiftHits
+             << '\n';
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Sets the length adjustment of each query with matches. The length adjustment depends only on refLen and the query
+//   length, it is computed once per distinct query length (in parallel) and looked up for each query.
 template <typename TInfix, typename TQueryId>
 void _postproccessLengthAdjustment(uint64_t const & refLen, StringSet<QueryMatches<StellarMatch<TInfix const, TQueryId> > > & matches)
 {
@@ -438,11 +767,26 @@ void _postproccessLengthAdjustment(uint64_t const & refLen, StringSet<QueryMatch
 
     constexpr bool is_dna5_or_rna5 = IsSameType<TAlphabet, Dna5>::VALUE || IsSameType<TAlphabet, Rna5>::VALUE;
     if constexpr (is_dna5_or_rna5) {
+        std::vector<uint64_t> queryLengths{};
+        for (QueryMatches<StellarMatch<TInfix const, TQueryId>> const & queryMatches : matches)
+            if (!empty(queryMatches.matches))
+                queryLengths.push_back(length(*front(queryMatches.matches).query));
+
+        std::sort(queryLengths.begin(), queryLengths.end());
+        queryLengths.erase(std::unique(queryLengths.begin(), queryLengths.end()), queryLengths.end());
+
+        std::vector<uint64_t> lengthAdjustments(queryLengths.size());
+        #pragma omp parallel for
+        for (size_t i = 0; i < queryLengths.size(); ++i)
+            lengthAdjustments[i] = _computeLengthAdjustment<uint64_t>(refLen, queryLengths[i]);
+
         for (QueryMatches<StellarMatch<TInfix const, TQueryId>> & queryMatches : matches) {
-            for (StellarMatch<TInfix const, TQueryId> & firstMatch : queryMatches.matches) {
-                queryMatches.lengthAdjustment = _computeLengthAdjustment<uint64_t>(refLen, length(source(firstMatch.row2)));
-                break;
-            }
+            if (empty(queryMatches.matches))
+                continue;
+
+            uint64_t const queryLength = length(*front(queryMatches.matches).query);
+            auto const it = std::lower_bound(queryLengths.begin(), queryLengths.end(), queryLength);
+            queryMatches.lengthAdjustment = lengthAdjustments[it - queryLengths.begin()];
         }
     }
 }
@@ -0,0 +1,20 @@
+
+#pragma once
+
+#include <stellar/stellar_database_segment.hpp>
+#include <stellar/stellar_query_segment.hpp>
+
+namespace stellar
+{
+
+///////////////////////////////////////////////////////////////////////////////
+// A swift hit that is collected for a later verification.
+template <typename TAlphabet>
+struct StellarSwiftHit
+{
+    StellarDatabaseSegment<TAlphabet> databaseSegment;
+    StellarQuerySegment<TAlphabet> querySegment;
+    unsigned delta; // delta + overlap of the swift pattern
+};
+
+} // namespace stellar
@@ -24,6 +24,12 @@
 #ifndef SEQAN_HEADER_STELLAR_TYPES_H
 #define SEQAN_HEADER_STELLAR_TYPES_H
 
+#include <cstdint>
+#include <set>
+#include <span>
+#include <tuple>
+#include <utility>
+
 #include <seqan/align.h>
 
 #include <stellar/options/dream_options.hpp>
@@ -50,17 +56,22 @@ struct StellarOptions : public EPSMatchOptions, public IndexOptions, public Veri
     CharString queryFile;           // name of query file
     CharString outputFile;          // name of result file
     CharString disabledQueriesFile; // name of result file containing disabled queries
-    CharString outputFormat;        // Possible formats: gff, text
+    CharString outputFormat;        // Possible formats: gff, text, smb (binary)
     CharString alphabet;            // Possible values: dna, rna, protein, char
+    CharString hitReportFile;       // name of SWIFT hit report file (no report if empty)
+    unsigned hitReportTop{20u};     // number of most hit SWIFT buckets in the hit report
+    bool streamOutput{false};       // write the matches after each database record instead of after each strand
+    bool compressOutput{false};     // write the output file BGZF compressed (output file ending in .gz or .bgz)
     bool noRT;                      // suppress printing of running time if set to true
 
     // more options
     unsigned threadCount{1u};   // The maximum number of threads
+    unsigned finderCount{1u};   // number of swift finders that scan disjoint ranges of a database segment
     bool forward;               // compute matches to forward strand of database
     bool reverse;               // compute matches to reverse complemented database
 
     unsigned disableThresh;     // maximal number of matches allowed per query before disabling verification of hits for that query
-    unsigned compactThresh;     // number of matches after which removal of overlaps and duplicates is started
+    unsigned compactThresh;     // number of kept or of removed matches per query after which the matches are compacted
     unsigned numMatches;        // maximal number of matches per query and database
     unsigned maxRepeatPeriod;   // maximal period of low complexity repeats to be filtered
     unsigned minRepeatLength;   // minimal length of low complexity repeats to be filtered
@@ -126,6 +137,7 @@ struct StellarOptions : public EPSMatchOptions, public IndexOptions, public Veri
 struct StellarStatistics
 {
     bool kMerComputed{};
+    bool lossless{}; // whether every eps-match is guaranteed to produce a SWIFT hit
     unsigned kMerLength{};
     unsigned smin{};
     int threshold{};
@@ -163,6 +175,7 @@ struct StellarStatistics
         size_t threshold0 = StellarOptions::kmerLemma(n0, kMerLength, e0);
         size_t threshold1 = StellarOptions::kmerLemma(n1, kMerLength, e1);
         threshold = std::max(size_t{1u}, std::min(threshold0, threshold1));
+        lossless = std::min(threshold0, threshold1) >= 1u;
 
         overlap = (int) floor((2 * threshold + kMerLength - 3) / (1 / (double)options.epsilon - kMerLength));
         distanceCut = (threshold - 1) + kMerLength * overlap + kMerLength;
@@ -174,6 +187,7 @@ struct StellarStatistics
 struct StellarComputeStatistics
 {
     size_t numSwiftHits = 0;
+    size_t numRejectedSwiftHits = 0; // swift hits skipped by the verification precheck (--precheck)
 
     size_t maxLength = 0;
     size_t totalLength = 0;
@@ -181,6 +195,7 @@ struct StellarComputeStatistics
     void mergeIn(StellarComputeStatistics const & statistics)
     {
         this->numSwiftHits += statistics.numSwiftHits;
+        this->numRejectedSwiftHits += statistics.numRejectedSwiftHits;
         this->totalLength += statistics.totalLength;
         this->maxLength = std::max<size_t>(this->maxLength, statistics.maxLength);
     }
@@ -222,17 +237,43 @@ private:
     std::vector<StellarComputeStatistics> _statistics; // one per database
 };
 
+///////////////////////////////////////////////////////////////////////////////
+// A run of count alignment columns of the same kind in the edit script of a StellarMatch.
+struct StellarEditRun
+{
+    enum Kind : uint32_t
+    {
+        aligned = 0,   // characters in both rows, a match or a mismatch (cigar M)
+        deletion = 1,  // a database character and a gap in the query row (cigar D)
+        insertion = 2  // a gap in the database row and a query character (cigar I)
+    };
+
+    static constexpr uint32_t maxCount = (uint32_t{1u} << 30) - 1u;
+
+    uint32_t kind : 2;
+    uint32_t count : 30;
+};
+
 ///////////////////////////////////////////////////////////////////////////////
 // Container for storing local alignment matches of one query sequence
+// _insertMatch keeps the non-overlapping longest matches. The valid matches are indexed by database begin position
+//   for the overlap checks and by length for removing the shortest matches. Removed matches stay in matches as
+//   invalid matches until they are compacted.
 template<typename TMatch_>
 struct QueryMatches {
     typedef typename Size<typename Source<TMatch_>::Type>::Type TSize;
+    typedef typename TMatch_::TPos TPos;
 
     String<TMatch_> matches;
+    String<StellarEditRun> editScripts; // the edit scripts of all matches, see StellarMatch
     bool disabled;
     TSize lengthAdjustment;
 
-    QueryMatches() : disabled(false), lengthAdjustment(0)
+    std::set<std::tuple<uint32_t, TPos, size_t>> matchesByBegin; // (databaseRecordID, begin1, index) of valid matches
+    std::set<std::pair<TPos, size_t>> matchesByLength;           // (end1 - begin1, index) of valid matches
+    TPos maxMatchSpan;              // maximal end1 - begin1 of the indexed matches
+
+    QueryMatches() : disabled(false), lengthAdjustment(0), maxMatchSpan(0)
     {}
 
     bool removeOverlapsAndCompactMatches(size_t const disableThresh,
@@ -240,10 +281,43 @@ struct QueryMatches {
                                          size_t const minLength,
                                          size_t const numMatches);
 
+    void _indexMatch(size_t const index);
+    void _unindexMatch(size_t const index);
+    void _rebuildMatchIndex();
+    void _compactMatchStorage();
 };
 
+///////////////////////////////////////////////////////////////////////////////
+// Appends the edit script of the alignment rows row0 (database) and row1 (query) to editScripts.
+template <typename TRow>
+inline void
+_appendEditScript(String<StellarEditRun> & editScripts, TRow const & row0, TRow const & row1)
+{
+    SEQAN_ASSERT_EQ(length(row0), length(row1));
+
+    size_t const editScriptBegin = length(editScripts);
+    auto it0 = begin(row0, Standard());
+    auto it1 = begin(row1, Standard());
+    auto const it0End = end(row0, Standard());
+    for (; it0 != it0End; ++it0, ++it1)
+    {
+        SEQAN_ASSERT(!isGap(it0) || !isGap(it1)); // no column consists of two gaps
+        uint32_t const kind = isGap(it0) ? StellarEditRun::insertion
+                            : (isGap(it1) ? StellarEditRun::deletion : StellarEditRun::aligned);
+
+        if (length(editScripts) > editScriptBegin && back(editScripts).kind == kind &&
+            back(editScripts).count < StellarEditRun::maxCount)
+            ++back(editScripts).count;
+        else
+            appendValue(editScripts, StellarEditRun{kind, 1u});
+    }
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // Container for storing a local alignment match
+// A match doesn't copy the alignment rows, it refers to the database and query sequence and stores the alignment
+//   as edit script, a range of runs in the editScripts of its QueryMatches.
+// The database is referred to by its record id, the database ids of type TId_ are only looked up for the output.
 template<typename TSequence_, typename TId_>
 struct StellarMatch {
     static_assert(std::is_const<TSequence_>::value, "Sequence must be const qualified! I.e. StellarMatch<... const, ...>");
@@ -251,44 +325,60 @@ struct StellarMatch {
     typedef TId_                                TId;
     typedef typename Position<TSequence>::Type  TPos;
 
+    // alignments that matches are constructed from
     typedef Align<TSequence, ArrayGaps>         TAlign;
-    typedef typename Row<TAlign>::Type         TRow;
-
-    static const TId INVALID_ID;
 
-    TId id;         // database ID
+    uint32_t databaseRecordID; // index of the database in the database ids
     bool orientation;
+    bool valid;                // false if the match was removed by maskOverlaps
     TPos begin1;
     TPos end1;
-    TRow row1;
 
     TPos begin2;
     TPos end2;
-    TRow row2;
 
-    StellarMatch() : id(), orientation(false), begin1(0), end1(0), begin2(0), end2(0)
+    TPos columns;   // number of alignment columns
+    TPos matchingColumns; // number of alignment columns with equal database and query characters, counted by _insertMatch
+    TSequence * database; // the (reverse complemented if !orientation) database sequence of row 1
+    TSequence * query;    // the query sequence of row 2
+
+    // the edit script are the runs [editScriptBegin, editScriptEnd) of QueryMatches::editScripts
+    size_t editScriptBegin;
+    size_t editScriptEnd;
+
+    StellarMatch() : databaseRecordID(0), orientation(false), valid(false), begin1(0), end1(0), begin2(0), end2(0), columns(0),
+                     matchingColumns(0), database(nullptr), query(nullptr), editScriptBegin(0), editScriptEnd(0)
     {}
 
-    template <typename TAlign, typename TId>
-    StellarMatch(TAlign & _align, TId _id, bool _orientation)
+    template <typename TAlignment>
+    StellarMatch(TAlignment const & _align, uint32_t _databaseRecordID, bool _orientation,
+                 String<StellarEditRun> & editScripts)
     {
-        id = _id;
+        databaseRecordID = _databaseRecordID;
         orientation = _orientation;
-        row1 = row(_align, 0);
-        row2 = row(_align, 1);
+        valid = true;
+
+        auto const & row1 = row(_align, 0);
+        auto const & row2 = row(_align, 1);
 
         begin1 = beginPosition(row1);
         end1 = endPosition(row1);
 
         begin2 = beginPosition(row2);
         end2 = endPosition(row2);
-    }
-};
 
-template <typename TSequence, typename TId>
-const TId
-StellarMatch<TSequence, TId>::INVALID_ID = "###########";
+        columns = length(row1);
+        database = &source(row1);
+        query = &source(row2);
 
+        editScriptBegin = length(editScripts);
+        _appendEditScript(editScripts, row1, row2);
+        editScriptEnd = length(editScripts);
+
+        // counted with _countMatchingColumns once the match is kept, see _insertMatch
+        matchingColumns = 0;
+    }
+};
 
 ///////////////////////////////////////////////////////////////////////////////
 
@@ -300,9 +390,9 @@ struct LessPos : public ::std::function<bool(TMatch, TMatch)> {
     LessPos() {}
 
     inline int compare(TMatch const & a, TMatch const & b) const {
-        // query number
-        if ((a.id) < (b.id)) return -1;
-        if ((a.id) > (b.id)) return 1;
+        // database number
+        if (a.databaseRecordID < b.databaseRecordID) return -1;
+        if (a.databaseRecordID > b.databaseRecordID) return 1;
 
         // database begin position
         typename TMatch::TPos aBegin1 = _min(a.begin1, a.end1);
@@ -352,8 +442,8 @@ struct LessLength : public ::std::function<bool(TMatch, TMatch)> {
     LessLength() {}
 
     inline int compare(TMatch const & a, TMatch const & b) const {
-        if (a.id == TMatch::INVALID_ID) return 1;
-        if (b.id == TMatch::INVALID_ID) return -1;
+        if (!a.valid) return 1;
+        if (!b.valid) return -1;
 
         typename TMatch::TPos aLength = abs((int)a.end1 - (int)a.begin1);
         typename TMatch::TPos bLength = abs((int)b.end1 - (int)b.begin1);
@@ -419,8 +509,78 @@ sortMatches(String<StellarMatch<TSequence const, TId> > & stellarMatches, TFunct
 // returns the length of the longer row from StellarMatch
 template <typename TSequence, typename TId>
 inline typename Size<TSequence const>::Type
-length(StellarMatch<TSequence const, TId> & match) {
-    return _max(length(match.row1), length(match.row2));
+length(StellarMatch<TSequence const, TId> const & match) {
+    return match.columns;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// returns the edit script of a StellarMatch
+template <typename TSequence, typename TId>
+inline std::span<StellarEditRun const>
+_editScript(StellarMatch<TSequence const, TId> const & match, String<StellarEditRun> const & editScripts)
+{
+    return {begin(editScripts, Standard()) + match.editScriptBegin, match.editScriptEnd - match.editScriptBegin};
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// returns the number of aligned columns of a StellarMatch with equal database and query characters
+template <typename TSequence, typename TId>
+inline typename StellarMatch<TSequence const, TId>::TPos
+_countMatchingColumns(StellarMatch<TSequence const, TId> const & match, String<StellarEditRun> const & editScripts)
+{
+    typedef typename StellarMatch<TSequence const, TId>::TPos TPos;
+
+    auto const & database = *match.database;
+    auto const & query = *match.query;
+
+    TPos matches = 0;
+    TPos dbPos = match.begin1;
+    TPos queryPos = match.begin2;
+    for (StellarEditRun const editRun : _editScript(match, editScripts)) {
+        if (editRun.kind == StellarEditRun::aligned) {
+            for (uint32_t i = 0; i < editRun.count; ++i)
+                if (database[dbPos + i] == query[queryPos + i])
+                    ++matches;
+        }
+        if (editRun.kind != StellarEditRun::insertion)
+            dbPos += editRun.count;
+        if (editRun.kind != StellarEditRun::deletion)
+            queryPos += editRun.count;
+    }
+    return matches;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// returns the alignment column of the first character of row 0 (database) or 1 (query) of a StellarMatch,
+//   i.e. toViewPosition(row, beginPosition(row))
+template <typename TSequence, typename TId, typename TRowNo>
+inline typename Size<TSequence const>::Type
+_viewBeginPosition(StellarMatch<TSequence const, TId> const & match,
+                   String<StellarEditRun> const & editScripts,
+                   TRowNo const row)
+{
+    std::span<StellarEditRun const> const editScript = _editScript(match, editScripts);
+    uint32_t const gapKind = (row == 0) ? StellarEditRun::insertion : StellarEditRun::deletion;
+    if (editScript.empty() || editScript.front().kind != gapKind)
+        return 0;
+    return editScript.front().count;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Copies the edit scripts of the matches into a new string, without the runs of removed matches.
+template <typename TMatch>
+inline void
+_compactEditScripts(String<TMatch> & matches, String<StellarEditRun> & editScripts)
+{
+    String<StellarEditRun> compactedEditScripts;
+    for (TMatch & match : matches)
+    {
+        size_t const editScriptBegin = length(compactedEditScripts);
+        append(compactedEditScripts, infix(editScripts, match.editScriptBegin, match.editScriptEnd));
+        match.editScriptBegin = editScriptBegin;
+        match.editScriptEnd = length(compactedEditScripts);
+    }
+    std::swap(editScripts, compactedEditScripts);
 }
 
 } // namespace stellar
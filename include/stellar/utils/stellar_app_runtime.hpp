@@ -29,6 +29,7 @@ struct stellar_app_runtime : public stellar_runtime
 {
     stellar_runtime input_queries_time{};
     stellar_runtime input_databases_time{};
+    stellar_runtime auto_tune_time{};
     stellar_runtime swift_index_construction_time{};
     stellar_strand_time forward_strand_stellar_time{};
     stellar_runtime reverse_complement_database_time{};
@@ -41,6 +42,7 @@ struct stellar_app_runtime : public stellar_runtime
         total.manual_timing(
             input_queries_time._runtime +
             input_databases_time._runtime +
+            auto_tune_time._runtime +
             swift_index_construction_time._runtime +
             forward_strand_stellar_time._runtime +
             reverse_complement_database_time._runtime +
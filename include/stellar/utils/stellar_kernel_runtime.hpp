@@ -43,16 +43,22 @@ struct stellar_extension_time : public stellar_runtime
 
 struct stellar_verification_time : public stellar_runtime
 {
+    stellar_runtime banded_local_score_time;
+    stellar_runtime precheck_time;
     stellar_runtime next_local_alignment_time;
     stellar_runtime split_at_x_drops_time;
+    stellar_runtime banded_global_alignment_time; // only measured by the verification strategy bandedGlobal
     stellar_extension_time extension_time;
 
     stellar_runtime total_time() const
     {
         stellar_runtime total{};
         total.manual_timing(
+            banded_local_score_time._runtime +
+            precheck_time._runtime +
             next_local_alignment_time._runtime +
             split_at_x_drops_time._runtime +
+            banded_global_alignment_time._runtime +
             extension_time._runtime);
 
         return total;
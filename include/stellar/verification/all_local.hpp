@@ -20,10 +20,12 @@ verifySwiftHit(Segment<Segment<TSequence const, InfixSegment>, InfixSegment> con
                TDelta const delta,
                TOnAlignmentResultFn && onAlignmentResult,
                stellar_verification_time & verification_runtime,
+               StellarVerificationContext<TSequence> & verification_context,
                AllLocal) {
 
     // false == all local matches
-    allOrBestLocal(infH, infV, eps, minLength, xDrop, delta, onAlignmentResult, verification_runtime, std::false_type{});
+    allOrBestLocal(infH, infV, eps, minLength, xDrop, delta, onAlignmentResult, verification_runtime, verification_context,
+                   std::false_type{});
 }
 
 } // namespace stellar
@@ -1,8 +1,12 @@
 
 #pragma once
 
+#include <algorithm>
+
+#include <stellar/stellar_extension.hpp>
 #include <stellar/stellar_types.hpp>
 #include <stellar/utils/stellar_kernel_runtime.hpp>
+#include <stellar/verification/verification_context.hpp>
 
 namespace stellar
 {
@@ -20,10 +24,10 @@ verifySwiftHit(Segment<Segment<TSequence const, InfixSegment>, InfixSegment> con
                TDelta const delta,
                TOnAlignmentResultFn && onAlignmentResult,
                stellar_verification_time & verification_runtime,
+               StellarVerificationContext<TSequence> & verification_context,
                BandedGlobal) {
     using TInfix = Segment<TSequence const, InfixSegment>;
     typedef Segment<TInfix, InfixSegment> TSegment;
-    typedef typename StellarMatch<TSequence const, CharString>::TAlign TAlign;
 
     // define a scoring scheme
     typedef int TScore;
@@ -37,31 +41,39 @@ verifySwiftHit(Segment<Segment<TSequence const, InfixSegment>, InfixSegment> con
     if (beginPosition(infV) == 0) upperDiag = lowerDiag + delta;
     if (endPosition(infV) == endPosition(host(infV))) lowerDiag = -(int64_t)delta;
 
+    // a global alignment needs both corners of the parallelogram in the band
+    int64_t const endDiag = (int64_t)length(infH) - (int64_t)length(infV);
+    lowerDiag = std::min({lowerDiag, endDiag, int64_t{0}});
+    upperDiag = std::max({upperDiag, endDiag, int64_t{0}});
+
     // banded alignment on parallelogram
     Align<TSegment> bandedAlign;
     resize(rows(bandedAlign), 2);
     assignSource(row(bandedAlign, 0), infH);
     assignSource(row(bandedAlign, 1), infV);
-    globalAlignment(bandedAlign, scoreMatrix, lowerDiag, upperDiag, NeedlemanWunsch());
-
-    longestEpsMatch(bandedAlign, minLength, eps);
+    verification_runtime.banded_global_alignment_time.measure_time([&]()
+    {
+        globalAlignment(bandedAlign, scoreMatrix, lowerDiag, upperDiag, NeedlemanWunsch());
+    });
 
     // integrate alignment in object of type TAlign
-    TAlign align;
+    auto & align = verification_context.align;
     resize(rows(align), 2);
     setSource(row(align, 0), host(host(infH)));
     setSource(row(align, 1), host(host(infV)));
     integrateAlign(align, bandedAlign);
 
-    // TODO(holtgrew): The following has not been adapted to the new clipping interface yet!
-    // set begin and end positions of align
-    SEQAN_FAIL("TODO(bkehr): Adapt to new clipping interface!");
-    setClippedBeginPosition(row(align, 0), beginPosition(infH) + clippedBeginPosition(row(bandedAlign, 0)));
-    setClippedBeginPosition(row(align, 1), beginPosition(infV) + beginPosition(host(infV)) + clippedBeginPosition(row(bandedAlign, 1)));
-    setBeginPosition(row(align, 0), 0);
-    setBeginPosition(row(align, 1), 0);
-    setClippedEndPosition(row(align, 0), beginPosition(infH) + clippedEndPosition(row(bandedAlign, 0)));
-    setClippedEndPosition(row(align, 1), beginPosition(infV) + beginPosition(host(infV)) + clippedEndPosition(row(bandedAlign, 1)));
+    // set begin and end positions of align (same as _extendAndExtract without extension)
+    setBeginPosition(row(align, 0), beginPosition(row(bandedAlign, 0)) + beginPosition(infH));
+    setBeginPosition(row(align, 1), beginPosition(row(bandedAlign, 1)) + beginPosition(infV));
+    setEndPosition(row(align, 0), endPosition(row(bandedAlign, 0)) + beginPosition(infH));
+    setEndPosition(row(align, 1), endPosition(row(bandedAlign, 1)) + beginPosition(infV));
+
+    if ((TSize)length(row(align, 0)) < minLength)
+        return;
+
+    // clips align to the longest contained eps-match (to nothing if there is none)
+    longestEpsMatch(align, minLength, eps, verification_context.extension.epsMatchGaps);
 
     if ((TSize)length(row(align, 0)) < minLength)
         return;
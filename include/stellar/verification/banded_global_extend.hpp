@@ -4,6 +4,7 @@
 #include <stellar/stellar_extension.hpp>
 #include <stellar/stellar_types.hpp>
 #include <stellar/utils/stellar_kernel_runtime.hpp>
+#include <stellar/verification/verification_context.hpp>
 
 namespace stellar
 {
@@ -21,10 +22,10 @@ verifySwiftHit(Segment<Segment<TSequence const, InfixSegment>, InfixSegment> con
                TDelta const delta,
                TOnAlignmentResultFn && onAlignmentResult,
                stellar_verification_time & verification_runtime,
+               StellarVerificationContext<TSequence> & verification_context,
                BandedGlobalExtend) {
     using TInfix = Segment<TSequence const, InfixSegment>;
     typedef Segment<TInfix, InfixSegment> TSegment;
-    typedef typename StellarMatch<TSequence const, CharString>::TAlign TAlign;
 
     // define a scoring scheme
     typedef int TScore;
@@ -46,15 +47,15 @@ verifySwiftHit(Segment<Segment<TSequence const, InfixSegment>, InfixSegment> con
     assignSource(row(bandedAlign, 1), infV);
     globalAlignment(bandedAlign, scoreMatrix, lowerDiag, upperDiag, NeedlemanWunsch());
 
-    // create alignment object for the complete sequences
-    TAlign align;
+    // alignment object for the complete sequences
+    auto & align = verification_context.align;
     resize(rows(align), 2);
     setSource(row(align, 0), host(host(infH)));
     setSource(row(align, 1), host(host(infV)));
 
     // extend alignment and obtain longest contained eps-match
     // TODO: something is wrong here, e.g. extract around seed, but also something else
-    if (!_extendAndExtract(bandedAlign, scoreDropOff, scoreMatrix, infH, infV, EXTEND_BOTH, minLength, eps, align, verification_runtime.extension_time))
+    if (!_extendAndExtract(bandedAlign, scoreDropOff, scoreMatrix, infH, infV, EXTEND_BOTH, minLength, eps, align, verification_context.extension, verification_runtime.extension_time))
         return;
 
     // insert eps-match in matches string
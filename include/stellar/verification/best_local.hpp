@@ -20,10 +20,12 @@ verifySwiftHit(Segment<Segment<TSequence const, InfixSegment>, InfixSegment> con
                /*unsigned_integral*/ TDelta const delta,
                TOnAlignmentResultFn && onAlignmentResult,
                stellar_verification_time & verification_runtime,
+               StellarVerificationContext<TSequence> & verification_context,
                BestLocal) {
 
     // true == best local match
-    allOrBestLocal(infH, infV, eps, minLength, xDrop, delta, onAlignmentResult, verification_runtime, std::true_type{});
+    allOrBestLocal(infH, infV, eps, minLength, xDrop, delta, onAlignmentResult, verification_runtime, verification_context,
+                   std::true_type{});
 }
 
 } // namespace stellar
@@ -2,14 +2,57 @@
 #pragma once
 
 #include <type_traits>
+#include <utility>
 
 #include <stellar/stellar_extension.hpp>
 #include <stellar/stellar_types.hpp>
 #include <stellar/utils/stellar_kernel_runtime.hpp>
+#include <stellar/verification/verification_context.hpp>
 
 namespace stellar
 {
 
+///////////////////////////////////////////////////////////////////////////////
+// Score of mismatches and indels of the banded local alignment in allOrBestLocal (matches score 1).
+template <typename TScore, typename TEpsilon, typename TSize>
+inline TScore
+_allOrBestLocalMismatchIndel(TEpsilon const eps, TSize const databaseLength) {
+    return (TScore)_max((TScore) ceil(-1/eps) + 1, -(TScore)databaseLength);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Minimal score of the local alignments (eps-cores) that allOrBestLocal extends.
+template <typename TEpsilon, typename TSize>
+inline TSize
+_allOrBestLocalMinScore(TEpsilon const eps, TSize const minLength) {
+    TEpsilon e = floor(eps*minLength);
+    TSize minLength1 = _max(0, (TSize)ceil((e+1) / eps));
+    TEpsilon e1 = floor(eps*minLength1);
+    return _min((TSize)ceil((minLength-e) / (e+1)), (TSize)ceil((minLength1-e1) / (e1+1)));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Lower and upper diagonal (database position - query position) of the band of the local alignment of a swift hit.
+template<typename TSequence, typename TDelta>
+inline std::pair<int64_t, int64_t>
+_allOrBestLocalDiagonals(Segment<Segment<TSequence const, InfixSegment>, InfixSegment> const & infH,
+                         Segment<Segment<TSequence const, InfixSegment>, InfixSegment> const & infV,
+                         TDelta const delta) {
+    int64_t upperDiag = 0;
+    int64_t lowerDiag = endPosition(infH) - (int64_t)endPosition(infV) - beginPosition(infH) + beginPosition(infV);
+    if (beginPosition(infV) == 0) {
+        if (endPosition(infV) == endPosition(host(infV))) {
+            // TODO: is it possible to get a smaller band in this case?
+            upperDiag = delta;
+            lowerDiag = -(int64_t)delta;
+        } else
+            upperDiag = lowerDiag + delta;
+    } else if (endPosition(infV) == endPosition(host(infV)))
+        lowerDiag = -(int64_t)delta;
+
+    return {lowerDiag, upperDiag};
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // Appends a segment of only error positions from align to queue.
 template<typename TAlign, typename TPos, typename TScoreValue>
@@ -68,16 +111,16 @@ _negativeMerge(String<TMerger> & queue) {
     TPos len = length(queue);
     if (len < 3) return false;
 
-    TMerger cd = value(queue, len-1);
-    TMerger bc = value(queue, len-2);
-    TMerger ab = value(queue, len-3);
+    TMerger const & cd = value(queue, len-1);
+    TMerger const & bc = value(queue, len-2);
+    TMerger const & ab = value(queue, len-3);
 
     if ((bc.i3 < 0) || (bc.i3 >= abs(_max(ab.i3, cd.i3)))) {
         return false;
     } else {
-        String<TMerger> newMerger;
-        appendValue(newMerger, TMerger(ab.i1, cd.i2, ab.i3 + bc.i3 + cd.i3));
-        replace(queue, len-3, len, newMerger);
+        // replaces ab, bc, cd by ad
+        queue[len-3] = TMerger(ab.i1, cd.i2, ab.i3 + bc.i3 + cd.i3);
+        resize(queue, len-2);
 
         return true;
     }
@@ -92,18 +135,19 @@ _positiveMerge(String<TMerger> & queue) {
     TPos len = length(queue);
     if (len < 5) return false;
 
-    TMerger ef = value(queue, len-1);
-    TMerger de = value(queue, len-2);
-    TMerger cd = value(queue, len-3);
-    TMerger bc = value(queue, len-4);
-    TMerger ab = value(queue, len-5);
+    TMerger const & ef = value(queue, len-1);
+    TMerger const & de = value(queue, len-2);
+    TMerger const & cd = value(queue, len-3);
+    TMerger const & bc = value(queue, len-4);
+    TMerger const & ab = value(queue, len-5);
 
     if ((cd.i3 >= 0) || (cd.i3 < _max(ab.i3, ef.i3))) {
         return false;
     } else {
-        String<TMerger> newMerger;
-        appendValue(newMerger, TMerger(bc.i1, de.i2, bc.i3 + cd.i3 + de.i3));
-        replace(queue, len-4, len-1, newMerger);
+        // replaces bc, cd, de by be
+        queue[len-4] = TMerger(bc.i1, de.i2, bc.i3 + cd.i3 + de.i3);
+        queue[len-3] = ef;
+        resize(queue, len-2);
 
         return true;
     }
@@ -111,19 +155,23 @@ _positiveMerge(String<TMerger> & queue) {
 
 ///////////////////////////////////////////////////////////////////////////////
 // Implements the algorithm from Zhang et al. in Bioinformatics, 1999: "Post-processing long pairwise alignments".
-// Splits an alignment into sub-alignments that contain no x-Drop.
+// Splits an alignment into sub-alignments that contain no x-Drop. The sub-alignments are stored as view position
+// ranges of align in scratch.clipRanges, see _clipToXDropRange.
 template<typename TAlign, typename TScoreValue, typename TScoreValue1, typename TScoreValue2>
 void
 _splitAtXDrops(TAlign const & align,
                Score<TScoreValue> const & scoreMatrix,
                TScoreValue1 const scoreDropOff,
                TScoreValue2 const minScore,
-               String<TAlign> & alignmentString) {
+               SplitAtXDropsScratch<typename Position<Row<TAlign> >::Type, TScoreValue> & scratch) {
     typedef typename Position<Row<TAlign> >::Type TPos;
     typedef Triple<TPos, TPos, TScoreValue> TMerger;
 
-    // initialization
-    String<TMerger> queue;
+    // initialization, keeps the capacity of the buffers
+    String<TMerger> & queue = scratch.queue;
+    clear(queue);
+    clear(scratch.clipRanges);
+
     TPos pos = _min(toViewPosition(row(align, 0), beginPosition(row(align, 0))),
                     toViewPosition(row(align, 1), beginPosition(row(align, 1))));
     appendValue(queue, TMerger(pos, pos, MinValue<TScoreValue1>::VALUE + 1));
@@ -143,38 +191,40 @@ _splitAtXDrops(TAlign const & align,
         // check for x-Drop
         len = length(queue);
         if ((len == 3) && (value(queue, 2).i3 < scoreDropOff * (-1))) {
-            if (value(queue, 1).i3 >= minScore) {
-                // create new sub-alignment
-                TAlign ali(align);
-                // std::cerr << "SEQ0 " << source(row(ali, 0)) << "\n";
-                // std::cerr << "SEQ1 " << source(row(ali, 1)) << "\n";
-                // std::cerr << "ROW0\n" << row(ali, 0) << "\nqueue[1].i1 == " << queue[1].i1 << ", queue[1].i2 == " << queue[1].i2 << "\n";
-                // std::cerr << "ROW1\n" << row(ali, 1) << "\nqueue[1].i1 == " << queue[1].i1 << ", queue[1].i2 == " << queue[1].i2 <<
-                        // "\n";
-                setClippedBeginPosition(row(ali, 0), queue[1].i1 + clippedBeginPosition(row(align, 0)));
-                setClippedBeginPosition(row(ali, 1), queue[1].i1 + clippedBeginPosition(row(align, 1)));
-                setClippedEndPosition(row(ali, 0), queue[1].i2 + clippedBeginPosition(row(align, 0)));
-                setClippedEndPosition(row(ali, 1), queue[1].i2 + clippedBeginPosition(row(align, 1)));
-
-                // TPos begin0 = toSourcePosition(row(ali, 0), value(queue, 1).i1);
-                // TPos begin1 = toSourcePosition(row(ali, 1), value(queue, 1).i1);
-                // TPos end0 = toSourcePosition(row(ali, 0), value(queue, 1).i2);
-                // TPos end1 = toSourcePosition(row(ali, 1), value(queue, 1).i2);
-                // setClippedBeginPosition(row(ali, 0), begin0);
-                // setClippedBeginPosition(row(ali, 1), begin1);
-                // setBeginPosition(row(ali, 0), 0);
-                // setBeginPosition(row(ali, 1), 0);
-                // setClippedEndPosition(row(ali, 0), end0);
-                // setClippedEndPosition(row(ali, 1), end1);
-
-                // append sub-alignment
-                appendValue(alignmentString, ali);
-            }
-            replace(queue, 0, 2, String<TMerger>());
+            // append sub-alignment
+            if (value(queue, 1).i3 >= minScore)
+                appendValue(scratch.clipRanges, XDropClipRange<TPos>{queue[1].i1, queue[1].i2});
+
+            // removes the first two segments
+            queue[0] = queue[2];
+            resize(queue, 1);
         }
     }
 }
 
+///////////////////////////////////////////////////////////////////////////////
+// Sets the clipping of gaps to the given unclipped view positions.
+template<typename TGaps, typename TPos>
+inline void
+_setUnclippedViewClipping(TGaps & gaps, TPos const unclippedBegin, TPos const unclippedEnd) {
+    clearClipping(gaps);
+    setClippedBeginPosition(gaps, unclippedBegin);
+    setClippedEndPosition(gaps, unclippedEnd);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Clips align in-place to a sub-alignment of _splitAtXDrops. clippedBegin0 and clippedBegin1 are the clipped begin
+// positions of the rows of align before it was split.
+template<typename TAlign, typename TPos>
+inline void
+_clipToXDropRange(TAlign & align,
+                  XDropClipRange<TPos> const & clipRange,
+                  TPos const clippedBegin0,
+                  TPos const clippedBegin1) {
+    _setUnclippedViewClipping(row(align, 0), clipRange.beginPosition + clippedBegin0, clipRange.endPosition + clippedBegin0);
+    _setUnclippedViewClipping(row(align, 1), clipRange.beginPosition + clippedBegin1, clipRange.endPosition + clippedBegin1);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // Conducts banded local alignment on swift hit (= computes eps-cores),
 //  splits eps-cores at X-drops, and calls _extendAndExtract for extension of eps-cores
@@ -189,10 +239,9 @@ allOrBestLocal(Segment<Segment<TSequence const, InfixSegment>, InfixSegment> con
                TDelta const delta,
                TOnAlignmentResultFn && onAlignmentResult,
                stellar_verification_time & verification_runtime,
+               StellarVerificationContext<TSequence> & verification_context,
                std::integral_constant<bool, bestLocalMethod>) {
-    using TInfix = Segment<TSequence const, InfixSegment>;
-    typedef Segment<TInfix, InfixSegment> TSegment;
-    typedef typename StellarMatch<TSequence const, seqan::CharString>::TAlign TAlign;
+    using TPos = typename StellarVerificationContext<TSequence>::TLocalAlignPosition;
 
     TSize maxLength = 1000000000;
     if ((TSize)length(infH) > maxLength) {
@@ -205,32 +254,20 @@ allOrBestLocal(Segment<Segment<TSequence const, InfixSegment>, InfixSegment> con
     // define a scoring scheme
     typedef int TScore;
     TScore match = 1;
-    TScore mismatchIndel = (TScore)_max((TScore) ceil(-1/eps) + 1, -(TScore)length(host(infH)));
+    TScore mismatchIndel = _allOrBestLocalMismatchIndel<TScore>(eps, length(host(infH)));
     Score<TScore> scoreMatrix(match, mismatchIndel, mismatchIndel);
     TScore scoreDropOff = (TScore) _max((TScore) xDrop * (-mismatchIndel), MinValue<TScore>::VALUE + 1);
 
     // calculate minimal score for local alignments
-    TEpsilon e = floor(eps*minLength);
-    TSize minLength1 = _max(0, (TSize)ceil((e+1) / eps));
-    TEpsilon e1 = floor(eps*minLength1);
-    TSize minScore = _min((TSize)ceil((minLength-e) / (e+1)), (TSize)ceil((minLength1-e1) / (e1+1)));
+    TSize minScore = _allOrBestLocalMinScore(eps, minLength);
 
     // diagonals for banded local alignment
-    int64_t upperDiag = 0;
-    int64_t lowerDiag = endPosition(infH) - (int64_t)endPosition(infV) - beginPosition(infH) + beginPosition(infV);
-    if (beginPosition(infV) == 0) {
-        if (endPosition(infV) == endPosition(host(infV))) {
-            // TODO: is it possible to get a smaller band in this case?
-            upperDiag = delta;
-            lowerDiag = -(int64_t)delta;
-        } else
-            upperDiag = lowerDiag + delta;
-    } else if (endPosition(infV) == endPosition(host(infV)))
-        lowerDiag = -(int64_t)delta;
+    auto [lowerDiag, upperDiag] = _allOrBestLocalDiagonals(infH, infV, delta);
 
     // banded local alignment
     LocalAlignmentEnumerator<Score<TScore>, Banded> enumerator(scoreMatrix, lowerDiag, upperDiag, minScore);
-    Align<TSegment> localAlign;
+    auto & localAlign = verification_context.localAlign;
+    auto & splitScratch = verification_context.splitAtXDrops;
     resize(rows(localAlign), 2);
     assignSource(row(localAlign, 0), infH);
     assignSource(row(localAlign, 1), infV);
@@ -249,45 +286,52 @@ allOrBestLocal(Segment<Segment<TSequence const, InfixSegment>, InfixSegment> con
         // std::cerr << "localAlign == \n" << localAlign << "\n";
 
         // split local alignments containing an X-drop
-        String<Align<TSegment> > seedAlignments;
         verification_runtime.split_at_x_drops_time.measure_time([&]()
         {
-            _splitAtXDrops(localAlign, scoreMatrix, scoreDropOff, minScore, seedAlignments);
+            _splitAtXDrops(localAlign, scoreMatrix, scoreDropOff, minScore, splitScratch);
         });
 
-        typename Iterator<String<Align<TSegment> > >::Type aliIt = begin(seedAlignments);
-        while (aliIt != end(seedAlignments)) {
-            // std::cerr << "aliIt == \n" << row(*aliIt, 0) << "\n" << row(*aliIt, 1) << "\n";
-            // create alignment object for the complete sequences
-            TAlign align;
+        // the seed alignments are clipped views of localAlign, the clipping is restored afterwards
+        TPos const clippedBegin0 = clippedBeginPosition(row(localAlign, 0));
+        TPos const clippedBegin1 = clippedBeginPosition(row(localAlign, 1));
+        TPos const clippedEnd0 = clippedEndPosition(row(localAlign, 0));
+        TPos const clippedEnd1 = clippedEndPosition(row(localAlign, 1));
+        size_t const seedCount = length(splitScratch.clipRanges);
+
+        for (size_t seedIndex = 0; seedIndex < seedCount; ++seedIndex) {
+            _clipToXDropRange(localAlign, splitScratch.clipRanges[seedIndex], clippedBegin0, clippedBegin1);
+
+            // alignment object for the complete sequences
+            auto & align = verification_context.align;
             resize(rows(align), 2);
             setSource(row(align, 0), host(host(infH)));
             setSource(row(align, 1), host(host(infV)));
 
             // determine extension direction
             ExtensionDirection direction;
-            if (length(seedAlignments) == 1) direction = EXTEND_BOTH;
-            else if (aliIt == begin(seedAlignments)) direction = EXTEND_RIGHT;
-            else if (aliIt == end(seedAlignments)-1) direction = EXTEND_LEFT;
+            if (seedCount == 1) direction = EXTEND_BOTH;
+            else if (seedIndex == 0) direction = EXTEND_RIGHT;
+            else if (seedIndex == seedCount - 1) direction = EXTEND_LEFT;
             else direction = EXTEND_NONE;
 
             bool const extension_succeeded = verification_runtime.extension_time.measure_time([&]()
             {
-                return _extendAndExtract(*aliIt, scoreDropOff, scoreMatrix, infH, infV, direction, minLength, eps, align, verification_runtime.extension_time);
+                return _extendAndExtract(localAlign, scoreDropOff, scoreMatrix, infH, infV, direction, minLength, eps, align, verification_context.extension, verification_runtime.extension_time);
             });
 
             // extend alignment and obtain longest contained eps-match
-            if (!extension_succeeded) {
-                aliIt++;
+            if (!extension_succeeded)
                 continue;
-            }
 
             // insert eps-match in matches string
             bool success = onAlignmentResult(align);
             if (!success)
                 return;
+        }
 
-            ++aliIt;
+        if (seedCount != 0) {
+            _setUnclippedViewClipping(row(localAlign, 0), clippedBegin0, clippedEnd0);
+            _setUnclippedViewClipping(row(localAlign, 1), clippedBegin1, clippedEnd1);
         }
         if (bestLocalMethod) break;
     }
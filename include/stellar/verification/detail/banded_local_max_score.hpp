@@ -0,0 +1,181 @@
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <tuple>
+#include <vector>
+
+#include <stellar/stellar_swift_hit.hpp>
+#include <stellar/verification/detail/all_or_best_local.hpp>
+#include <stellar/verification/detail/banded_local_score_buffers.hpp>
+
+namespace stellar
+{
+
+// maximal query length and maximal absolute mismatch score for which no score of a lane can overflow
+constexpr int64_t _bandedLocalMaxScoreLimit = std::numeric_limits<int16_t>::max() / 2;
+
+///////////////////////////////////////////////////////////////////////////////
+// vectorMax = max(vectorMax, other) for each lane.
+inline void
+_vectorMax(StellarBandedLocalScoreVector & vectorMax, StellarBandedLocalScoreVector const & other)
+{
+    StellarBandedLocalScoreVector const greater = other > vectorMax;
+    vectorMax = (other & greater) | (vectorMax & ~greater);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Computes the maximal banded local score of the swift hits hitIDs (at most _bandedLocalBatchSize), one swift hit
+// per lane. The band of each swift hit is shifted such that all lanes compute the same cells
+// (query position, diagonal offset), the bands are taken from buffers.bands.
+template <typename TAlphabet>
+inline void
+_bandedLocalMaxScoresOfBatch(std::span<StellarSwiftHit<TAlphabet> const> const swiftHits,
+                             std::span<size_t const> const hitIDs,
+                             std::span<int> const maxScores,
+                             StellarBandedLocalScoreBuffers & buffers)
+{
+    using TVector = StellarBandedLocalScoreVector;
+    constexpr int16_t querySentinel = -1;
+    constexpr int16_t databaseSentinel = -2;
+
+    size_t const laneCount = hitIDs.size();
+    SEQAN_ASSERT_LEQ(laneCount, _bandedLocalBatchSize);
+
+    int64_t rowCount = 0;
+    int64_t bandWidth = 1;
+    TVector errorScore{};
+    for (size_t lane = 0; lane < laneCount; ++lane)
+    {
+        StellarBandedLocalBand const & band = buffers.bands[hitIDs[lane]];
+        errorScore[lane] = band.mismatchIndel;
+        rowCount = std::max(rowCount, band.queryLength);
+        bandWidth = std::max(bandWidth, band.bandWidth);
+    }
+
+    // query[v] and database[v + k] are the characters of cell (v, k) = (query position v, database position
+    // v + lowerDiag + k), or sentinels that never match outside of the sequences
+    std::vector<TVector> & query = buffers.query;
+    std::vector<TVector> & database = buffers.database;
+    std::vector<TVector> & inBand = buffers.inBand;
+    query.resize(rowCount);
+    database.resize(rowCount + bandWidth);
+    inBand.resize(bandWidth);
+
+    for (size_t lane = 0; lane < _bandedLocalBatchSize; ++lane)
+    {
+        bool const active = lane < laneCount;
+        StellarBandedLocalBand const band = active ? buffers.bands[hitIDs[lane]] : StellarBandedLocalBand{};
+
+        for (int64_t v = 0; v < rowCount; ++v)
+        {
+            query[v][lane] = (active && v < band.queryLength)
+                           ? (int16_t)ordValue(swiftHits[hitIDs[lane]].querySegment.asInfixSegment()[v])
+                           : querySentinel;
+        }
+
+        for (int64_t j = 0; j < rowCount + bandWidth; ++j)
+        {
+            int64_t const h = active ? j + band.lowerDiag : -1;
+            database[j][lane] = (h >= 0 && h < band.databaseLength)
+                              ? (int16_t)ordValue(swiftHits[hitIDs[lane]].databaseSegment.asInfixSegment()[h])
+                              : databaseSentinel;
+        }
+
+        for (int64_t k = 0; k < bandWidth; ++k)
+            inBand[k][lane] = (active && k < band.bandWidth) ? -1 : 0;
+    }
+
+    TVector const zero{};
+    TVector const matchScore = zero + 1;
+
+    // previousRow[bandWidth] stays zero, it is the cell above the band
+    std::vector<TVector> & previousRow = buffers.previousRow;
+    std::vector<TVector> & currentRow = buffers.currentRow;
+    previousRow.assign(bandWidth + 1, zero);
+    currentRow.assign(bandWidth + 1, zero);
+    TVector maxScore = zero;
+
+    // Cells outside of the band or the sequences are zero (or at most a gap away from a cell in the band), which
+    // doesn't change the maximal score of a local alignment.
+    for (int64_t v = 0; v < rowCount; ++v)
+    {
+        TVector left = zero;
+        for (int64_t k = 0; k < bandWidth; ++k)
+        {
+            TVector const equal = query[v] == database[v + k];
+            TVector score = previousRow[k] + ((matchScore & equal) | (errorScore & ~equal));
+            _vectorMax(score, previousRow[k + 1] + errorScore);
+            _vectorMax(score, left + errorScore);
+            _vectorMax(score, zero);
+            score &= inBand[k];
+
+            currentRow[k] = score;
+            left = score;
+            _vectorMax(maxScore, score);
+        }
+        std::swap(previousRow, currentRow);
+    }
+
+    for (size_t lane = 0; lane < laneCount; ++lane)
+        maxScores[hitIDs[lane]] = maxScore[lane];
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Computes the maximal score of a banded local alignment for each of the given swift hits, using the same scoring
+// scheme and band as allOrBestLocal. The swift hits are sorted by band width and query length and aligned in batches
+// of _bandedLocalBatchSize, such that the lanes of a batch compute few cells outside of their own band.
+// Swift hits whose scores could overflow 16 bit get the maximal score std::numeric_limits<int>::max().
+template <typename TAlphabet, typename TEpsilon>
+inline void
+_bandedLocalMaxScores(std::span<StellarSwiftHit<TAlphabet> const> const swiftHits,
+                      TEpsilon const eps,
+                      std::span<int> const maxScores,
+                      StellarBandedLocalScoreBuffers & buffers)
+{
+    SEQAN_ASSERT_EQ(swiftHits.size(), maxScores.size());
+
+    std::fill(maxScores.begin(), maxScores.end(), std::numeric_limits<int>::max());
+
+    buffers.bands.resize(swiftHits.size());
+    buffers.hitOrder.clear();
+    for (size_t hitID = 0; hitID < swiftHits.size(); ++hitID)
+    {
+        StellarDatabaseSegment<TAlphabet> const & databaseSegment = swiftHits[hitID].databaseSegment;
+        StellarQuerySegment<TAlphabet> const & querySegment = swiftHits[hitID].querySegment;
+
+        auto const [lowerDiag, upperDiag] = _allOrBestLocalDiagonals(databaseSegment.asFinderSegment(),
+                                                                      querySegment.asPatternSegment(),
+                                                                      swiftHits[hitID].delta);
+        int const mismatchIndel = _allOrBestLocalMismatchIndel<int>(eps, length(databaseSegment.underlyingDatabase()));
+
+        if ((int64_t)querySegment.size() > _bandedLocalMaxScoreLimit ||
+            -mismatchIndel > _bandedLocalMaxScoreLimit ||
+            upperDiag < lowerDiag)
+            continue;
+
+        buffers.bands[hitID] = StellarBandedLocalBand{lowerDiag, upperDiag - lowerDiag + 1,
+                                                      (int64_t)databaseSegment.size(), (int64_t)querySegment.size(),
+                                                      mismatchIndel};
+        buffers.hitOrder.push_back(hitID);
+    }
+
+    std::sort(buffers.hitOrder.begin(), buffers.hitOrder.end(), [&](size_t const hitA, size_t const hitB)
+    {
+        StellarBandedLocalBand const & a = buffers.bands[hitA];
+        StellarBandedLocalBand const & b = buffers.bands[hitB];
+        return std::tie(a.bandWidth, a.queryLength, hitA) < std::tie(b.bandWidth, b.queryLength, hitB);
+    });
+
+    std::span<size_t const> const hitOrder{buffers.hitOrder};
+    for (size_t batchBegin = 0; batchBegin < hitOrder.size(); batchBegin += _bandedLocalBatchSize)
+    {
+        size_t const batchSize = std::min(_bandedLocalBatchSize, hitOrder.size() - batchBegin);
+        _bandedLocalMaxScoresOfBatch(swiftHits, hitOrder.subspan(batchBegin, batchSize), maxScores, buffers);
+    }
+}
+
+} // namespace stellar
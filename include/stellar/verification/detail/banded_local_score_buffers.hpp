@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace stellar
+{
+
+// number of swift hits that are aligned at once, one per vector lane
+constexpr size_t _bandedLocalBatchSize = 16u;
+
+using StellarBandedLocalScoreVector = int16_t __attribute__((vector_size(_bandedLocalBatchSize * sizeof(int16_t))));
+
+///////////////////////////////////////////////////////////////////////////////
+// Band of the banded local alignment of one swift hit, see _bandedLocalMaxScores.
+struct StellarBandedLocalBand
+{
+    int64_t lowerDiag;
+    int64_t bandWidth;
+    int64_t databaseLength;
+    int64_t queryLength;
+    int mismatchIndel;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+// Buffers of _bandedLocalMaxScores, they keep their capacity between calls.
+struct StellarBandedLocalScoreBuffers
+{
+    // band of each swift hit and the swift hits (by index) in the order in which they are put into the lanes
+    std::vector<StellarBandedLocalBand> bands{};
+    std::vector<size_t> hitOrder{};
+
+    // characters, band masks and the last two rows of one batch of lanes
+    std::vector<StellarBandedLocalScoreVector> query{};
+    std::vector<StellarBandedLocalScoreVector> database{};
+    std::vector<StellarBandedLocalScoreVector> inBand{};
+    std::vector<StellarBandedLocalScoreVector> previousRow{};
+    std::vector<StellarBandedLocalScoreVector> currentRow{};
+};
+
+} // namespace stellar
@@ -0,0 +1,157 @@
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <vector>
+
+#include <stellar/stellar_database_segment.hpp>
+#include <stellar/stellar_query_segment.hpp>
+#include <stellar/options/eps_match_options.hpp>
+#include <stellar/options/verifier_options.hpp>
+#include <stellar/utils/stellar_kernel_runtime.hpp>
+
+namespace stellar
+{
+
+///////////////////////////////////////////////////////////////////////////////
+// Myers' bit-vector algorithm: returns the minimal edit distance of the pattern
+// (at most 64 characters) to any substring of text.
+template <typename TPattern, typename TText>
+inline unsigned
+_myersMinimalEditDistance(TPattern const & pattern, TText const & text, std::vector<uint64_t> & patternMasks)
+{
+    using TAlphabet = typename Value<TPattern>::Type;
+
+    unsigned const patternLength = length(pattern);
+    SEQAN_ASSERT_GT(patternLength, 0u);
+    SEQAN_ASSERT_LEQ(patternLength, 64u);
+
+    patternMasks.assign(ValueSize<TAlphabet>::VALUE, uint64_t{0u});
+    for (unsigned i = 0; i < patternLength; ++i)
+        patternMasks[ordValue(pattern[i])] |= uint64_t{1u} << i;
+
+    uint64_t const lastBit = uint64_t{1u} << (patternLength - 1);
+    uint64_t vp = ~uint64_t{0u};
+    uint64_t vn = 0u;
+    unsigned errors = patternLength;
+    unsigned minErrors = patternLength;
+
+    for (auto it = begin(text); it != end(text); ++it)
+    {
+        uint64_t const eq = patternMasks[ordValue(static_cast<TAlphabet>(*it))];
+        uint64_t const xv = eq | vn;
+        uint64_t const xh = (((eq & vp) + vp) ^ vp) | eq;
+        uint64_t hp = vn | ~(xh | vp);
+        uint64_t hn = vp & xh;
+
+        if (hp & lastBit)
+            ++errors;
+        else if (hn & lastBit)
+            --errors;
+
+        // the first row is zero, a match may start anywhere in text
+        hp <<= 1;
+        hn <<= 1;
+        vp = hn | ~(xv | hp);
+        vn = hp & xv;
+
+        minErrors = std::min(minErrors, errors);
+    }
+
+    return minErrors;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Cheap test whether the band of a swift hit can contain an eps-match of length minLength.
+// The query segment is cut into blocks and a lower bound of the errors of each block is computed with Myers'
+// algorithm against the diagonal range of the hit (widened by delta). An eps-match contains a run of consecutive
+// blocks and has at least the sum of their errors. Returns false only if no run of blocks is long enough and has
+// few enough errors, i.e. if the band provably contains no eps-match of length minLength.
+template <typename TAlphabet>
+inline bool
+_swiftHitMayContainEpsMatch(StellarDatabaseSegment<TAlphabet> const & databaseSegment,
+                            StellarQuerySegment<TAlphabet> const & querySegment,
+                            double const eps,
+                            unsigned const minLength,
+                            unsigned const delta)
+{
+    // an eps-match of length minLength spans at least minQueryLength query positions
+    double const minQueryLength = minLength * (1 - eps);
+    int64_t const blockLength = std::min<int64_t>(64, static_cast<int64_t>(minQueryLength) / 4);
+
+    // blocks would be too short to give a useful bound
+    if (blockLength < 4 || eps >= 1)
+        return true;
+
+    auto const databaseInfix = databaseSegment.asInfixSegment();
+    auto const queryInfix = querySegment.asInfixSegment();
+    int64_t const databaseLength = length(databaseInfix);
+    int64_t const queryLength = length(queryInfix);
+
+    // covers the band of all verification methods (diagonal = database position - query position)
+    int64_t const diagonalWidth = std::abs(databaseLength - queryLength) + delta;
+
+    // A match that contains m full blocks spans less than (m + 2) * blockLength query positions and thus has at most
+    // eps * ((m + 2) * blockLength - 2) / (1 - eps) errors. It contains at least minBlocks full blocks.
+    double const errorsPerBlock = eps * blockLength / (1 - eps);
+    double const errorsOffset = eps * (2 * blockLength - 2) / (1 - eps) + 1e-9;
+    int64_t const minBlocks = static_cast<int64_t>(std::ceil((minQueryLength + 2) / blockLength)) - 2;
+
+    std::vector<uint64_t> patternMasks{};
+    std::vector<double> prefixSums{0.0}; // prefixSums[k] = sum of (errors - errorsPerBlock) of the first k blocks
+    double maxPrefixSum = -std::numeric_limits<double>::infinity();
+
+    for (int64_t blockBegin = 0; blockBegin + blockLength <= queryLength; blockBegin += blockLength)
+    {
+        int64_t const textBegin = std::clamp<int64_t>(blockBegin - diagonalWidth, 0, databaseLength);
+        int64_t const textEnd = std::clamp<int64_t>(blockBegin + blockLength + diagonalWidth, 0, databaseLength);
+
+        unsigned const errors = _myersMinimalEditDistance(infix(queryInfix, blockBegin, blockBegin + blockLength),
+                                                          infix(databaseInfix, textBegin, textEnd),
+                                                          patternMasks);
+        prefixSums.push_back(prefixSums.back() + errors - errorsPerBlock);
+
+        // check all runs of at least minBlocks blocks that end with this block
+        int64_t const runEnd = prefixSums.size() - 1;
+        if (runEnd < minBlocks)
+            continue;
+
+        maxPrefixSum = std::max(maxPrefixSum, prefixSums[runEnd - minBlocks]);
+        if (prefixSums[runEnd] - maxPrefixSum <= errorsOffset)
+            return true;
+    }
+
+    return false;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Returns false if the swift hit can be skipped, because its band can't contain an eps-match.
+// Always true if the precheck is disabled.
+template <typename TAlphabet, typename TDelta>
+inline bool
+_precheckSwiftHit(StellarDatabaseSegment<TAlphabet> const & databaseSegment,
+                  StellarQuerySegment<TAlphabet> const & querySegment,
+                  TDelta const delta,
+                  EPSMatchOptions const & eps_match_options,
+                  VerifierOptions const & verifier_options,
+                  stellar_verification_time & verification_runtime)
+{
+    if (!verifier_options.precheck)
+        return true;
+
+    return verification_runtime.precheck_time.measure_time([&]()
+    {
+        return _swiftHitMayContainEpsMatch(
+            databaseSegment,
+            querySegment,
+            (double)eps_match_options.epsilon,
+            eps_match_options.minLength,
+            delta);
+    });
+}
+
+} // namespace stellar
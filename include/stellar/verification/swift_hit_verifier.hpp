@@ -6,6 +6,7 @@
 #include <stellar/options/eps_match_options.hpp>
 #include <stellar/options/verifier_options.hpp>
 #include <stellar/utils/stellar_kernel_runtime.hpp>
+#include <stellar/verification/verification_context.hpp>
 
 namespace stellar {
 
@@ -20,7 +21,8 @@ struct SwiftHitVerifier
                 StellarQuerySegment<TAlphabet> const & querySegment,
                 TDelta const delta,
                 TOnAlignmentResultFn && onAlignmentResult,
-                stellar_verification_time & verification_runtime)
+                stellar_verification_time & verification_runtime,
+                StellarVerificationContext<String<TAlphabet>> & verification_context)
     {
         static_assert(std::is_unsigned<TDelta>::value, "TDelta must be unsigned integral.");
 
@@ -33,6 +35,7 @@ struct SwiftHitVerifier
             delta,
             onAlignmentResult,
             verification_runtime,
+            verification_context,
             TVerifierTag{});
     }
 };
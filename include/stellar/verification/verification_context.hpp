@@ -0,0 +1,56 @@
+
+#pragma once
+
+#include <vector>
+
+#include <stellar/extension/extension_buffers.hpp>
+#include <stellar/stellar_types.hpp>
+#include <stellar/verification/detail/banded_local_score_buffers.hpp>
+
+namespace stellar
+{
+
+///////////////////////////////////////////////////////////////////////////////
+// A sub-alignment found by _splitAtXDrops, given as range of view positions of the split alignment.
+template<typename TPos>
+struct XDropClipRange
+{
+    TPos beginPosition;
+    TPos endPosition;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+// Buffers of _splitAtXDrops, that are reused for all alignments split by one thread.
+template<typename TPos, typename TScoreValue>
+struct SplitAtXDropsScratch
+{
+    String<Triple<TPos, TPos, TScoreValue> > queue;
+    String<XDropClipRange<TPos> > clipRanges;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+// Owns the alignments and buffers that the verification of a swift hit needs, such that verifying many swift hits
+// reuses the same memory. A context must not be used by two threads at the same time.
+template <typename TSequence>
+struct StellarVerificationContext
+{
+    using TSegment = Segment<Segment<TSequence const, InfixSegment>, InfixSegment>;
+    using TLocalAlign = Align<TSegment>;
+    using TLocalAlignPosition = typename Position<typename Row<TLocalAlign>::Type>::Type;
+    using TAlign = typename StellarMatch<TSequence const, CharString>::TAlign;
+
+    // banded local alignment (eps-core) of the swift hit
+    TLocalAlign localAlign{};
+    SplitAtXDropsScratch<TLocalAlignPosition, int> splitAtXDrops{};
+
+    // eps-match on the complete sequences, is handed to onAlignmentResult
+    TAlign align{};
+
+    StellarExtensionBuffers<TSequence> extension{};
+
+    // maximal banded local scores of the swift hits that are verified together, see _verifySwiftHits
+    std::vector<int> bandedLocalMaxScores{};
+    StellarBandedLocalScoreBuffers bandedLocalScore{};
+};
+
+} // namespace stellar
@@ -21,6 +21,8 @@
 // Author: Birte Kehr <birte.kehr@fu-berlin.de>
 // ==========================================================================
 
+#include <string_view>
+
 #include <seqan/arg_parse.h>
 #include <seqan/index.h>
 #include <seqan/seq_io.h>
@@ -29,11 +31,13 @@
 #include <stellar/stellar_output.hpp>
 
 #include <stellar/app/stellar.arg_parser.hpp>
+#include <stellar/app/stellar.convert.hpp>
 #include <stellar/app/stellar.diagnostics.hpp>
 #include <stellar/app/stellar.main.hpp>
 
 #ifndef STELLAR_PARALLEL_BUILD
 #include "stellar/stellar.arg_parser.cpp"
+#include "stellar/stellar.convert.cpp"
 #include "stellar/stellar.diagnostics.cpp"
 #include <stellar/app/stellar.main.tpp>
 #endif // STELLAR_PARALLEL_BUILD
@@ -64,6 +68,10 @@ int main(int argc, const char * argv[])
     // Makes sure that printing doubles in scientific notation is normalized on all platforms.
     ScientificNotationExponentOutputNormalizer scientificNotationNormalizer;
 
+    // `stellar convert` converts binary match files
+    if (argc > 1 && std::string_view{argv[1]} == "convert")
+        return stellar::app::convertMain(argc - 1, argv + 1);
+
     // command line parsing
     seqan::ArgumentParser parser("stellar");
 
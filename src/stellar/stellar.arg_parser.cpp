@@ -19,15 +19,31 @@ _parseOptions(ArgumentParser const & parser, StellarOptions & options)
     // output options
     getOptionValue(options.outputFile, parser, "out");
     getOptionValue(options.disabledQueriesFile, parser, "outDisabled");
+    getOptionValue(options.hitReportFile, parser, "hitReport");
+    getOptionValue(options.hitReportTop, parser, "hitReportTop");
+    getOptionValue(options.streamOutput, parser, "streamOutput");
     getOptionValue(options.noRT, parser, "no-rt");
 
     CharString tmp = options.outputFile;
     toLower(tmp);
 
+    if (endsWith(tmp, ".gz") || endsWith(tmp, ".bgz"))
+    {
+#if SEQAN_HAS_ZLIB
+        options.compressOutput = true;
+        resize(tmp, length(tmp) - (endsWith(tmp, ".gz") ? 3 : 4));
+#else
+        std::cerr << "Invalid parameter value: Writing a compressed output file requires zlib." << std::endl;
+        return ArgumentParser::PARSE_ERROR;
+#endif // SEQAN_HAS_ZLIB
+    }
+
     if (endsWith(tmp, ".gff"))
         options.outputFormat = "gff";
     else if (endsWith(tmp, ".txt"))
         options.outputFormat = "txt";
+    else if (endsWith(tmp, ".smb"))
+        options.outputFormat = "smb";
 
     // main options
     double epsilon{};
@@ -35,6 +51,7 @@ _parseOptions(ArgumentParser const & parser, StellarOptions & options)
     getOptionValue(options.minLength, parser, "minLength");
     getOptionValue(epsilon, parser, "epsilon");
     getOptionValue(options.xDrop, parser, "xDrop");
+    getOptionValue(options.precheck, parser, "precheck");
     getOptionValue(options.alphabet, parser, "alphabet");
     getOptionValue(options.threadCount, parser, "threads");
 
@@ -79,6 +96,8 @@ _parseOptions(ArgumentParser const & parser, StellarOptions & options)
     getOptionValue(options.maxRepeatPeriod, parser, "repeatPeriod");
     getOptionValue(options.minRepeatLength, parser, "repeatLength");
     getOptionValue(options.qgramAbundanceCut, parser, "abundanceCut");
+    getOptionValue(options.autoTuneQGram, parser, "auto-tune");
+    getOptionValue(options.finderCount, parser, "finderCount");
 
     getOptionValue(options.verbose, parser, "verbose");
 
@@ -88,6 +107,12 @@ _parseOptions(ArgumentParser const & parser, StellarOptions & options)
         return ArgumentParser::PARSE_ERROR;
     }
 
+    if (isSet(parser, "kmer") && options.autoTuneQGram)
+    {
+        std::cerr << "Invalid parameter values: Please choose either --kmer or --auto-tune." << std::endl;
+        return ArgumentParser::PARSE_ERROR;
+    }
+
     if (options.numMatches > options.compactThresh)
     {
         std::cerr << "Invalid parameter values: Please choose numMatches <= sortThresh." << std::endl;
@@ -161,6 +186,14 @@ void _setParser(ArgumentParser & parser)
     addOption(parser, ArgParseOption("k", "kmer", "Length of the q-grams (max 32).", ArgParseArgument::INTEGER));
     setMinValue(parser, "k", "1");
     setMaxValue(parser, "k", "32");
+    addOption(parser, ArgParseOption("", "auto-tune",
+                                     "Choose the k-mer length by running filtering and verification on a random sample "
+                                     "of the database for several lossless k-mer lengths."));
+    addOption(parser, ArgParseOption("", "finderCount",
+                                     "Number of SWIFT finders that scan disjoint ranges of each database sequence in "
+                                     "parallel (uses up to --threads threads).", ArgParseArgument::INTEGER));
+    setMinValue(parser, "finderCount", "1");
+    setDefaultValue(parser, "finderCount", "1");
     addOption(parser, ArgParseOption("rp", "repeatPeriod",
                                      "Maximal period of low complexity repeats to be filtered.", ArgParseArgument::INTEGER));
     setDefaultValue(parser, "rp", "1");
@@ -183,6 +216,9 @@ void _setParser(ArgumentParser & parser)
     //addHelpLine(parser, "bandedGlobal = banded global alignment on SWIFT hits");
     setDefaultValue(parser, "vs", "exact");
     setValidValues(parser, "vs", "exact bestLocal bandedGlobal");
+    addOption(parser, ArgParseOption("", "precheck",
+                                     "Skip SWIFT hits whose band provably contains no epsilon-match of minimal length "
+                                     "(bit-parallel edit distance bound) before verifying them."));
     addOption(parser, ArgParseOption("dt", "disableThresh",
                                      "Maximal number of verified matches before disabling verification for one query "
                                      "sequence (default infinity).", ArgParseArgument::INTEGER));
@@ -192,19 +228,32 @@ void _setParser(ArgumentParser & parser)
                                      "only the longest ones are kept.", ArgParseArgument::INTEGER));
     setDefaultValue(parser, "n", "50");
     addOption(parser, ArgParseOption("s", "sortThresh",
-                                     "Number of matches triggering removal of duplicates. Choose a smaller value for saving "
+                                     "Number of kept matches triggering removal of all but the longest ones, and of removed "
+                                     "duplicate matches triggering freeing their memory. Choose a smaller value for saving "
                                      "space.", ArgParseArgument::INTEGER));
     setDefaultValue(parser, "s", "500");
 
     addSection(parser, "Output Options");
 
     addOption(parser, ArgParseOption("o", "out", "Name of output file.", ArgParseArgument::OUTPUT_FILE));
-    setValidValues(parser, "o", "gff txt");
+    setValidValues(parser, "o", "gff txt smb gff.gz txt.gz gff.bgz txt.bgz");
     setDefaultValue(parser, "o", "stellar.gff");
     addOption(parser, ArgParseOption("od", "outDisabled",
                                      "Name of output file for disabled query sequences.", ArgParseArgument::OUTPUT_FILE));
     setValidValues(parser, "outDisabled", seqan::SeqFileOut::getFileExtensions());
     setDefaultValue(parser, "od", "stellar.disabled.fasta");
+    addOption(parser, ArgParseOption("", "hitReport",
+                                     "Name of output file for a report of the SWIFT hits per query and of the SWIFT "
+                                     "buckets with the most hits.", ArgParseArgument::OUTPUT_FILE));
+    setValidValues(parser, "hitReport", "tsv");
+    addOption(parser, ArgParseOption("", "hitReportTop",
+                                     "Number of SWIFT buckets with the most hits listed in the hit report.",
+                                     ArgParseArgument::INTEGER));
+    setMinValue(parser, "hitReportTop", "0");
+    setDefaultValue(parser, "hitReportTop", "20");
+    addOption(parser, ArgParseOption("", "streamOutput",
+                                     "Write the matches of each database sequence as soon as it is searched. The maximal "
+                                     "number of matches and the disable threshold apply per query and database sequence."));
     addOption(parser, ArgParseOption("no-rt", "suppress-runtime-printing", "Suppress printing running time."));
     hideOption(parser, "no-rt");
 
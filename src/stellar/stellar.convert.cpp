@@ -0,0 +1,68 @@
+#include <stellar/app/stellar.convert.hpp>
+
+#include <fstream>
+
+#include <stellar/stellar_binary_output.hpp>
+
+namespace stellar
+{
+
+namespace app
+{
+
+///////////////////////////////////////////////////////////////////////////////
+// Set-Up of Argument Parser of `stellar convert`
+void _setConvertParser(ArgumentParser & parser)
+{
+    setShortDescription(parser, "converts binary STELLAR match files");
+    setDate(parser, SEQAN_DATE);
+    setVersion(parser, SEQAN_APP_VERSION " [" SEQAN_REVISION "]");
+    setCategory(parser, "Local Alignment");
+
+    addUsageLine(parser, "<\\fIBINARY MATCH FILE\\fP> <\\fIGFF FILE\\fP>");
+
+    addDescription(parser,
+                   "Writes the matches of a binary match file, written by stellar with an output file "
+                   "ending in .smb, in gff format. The gff file is the same as the one stellar writes "
+                   "with an output file ending in .gff.");
+
+    addArgument(parser, ArgParseArgument(ArgParseArgument::INPUT_FILE, "BINARY MATCH FILE"));
+    setValidValues(parser, 0, "smb");
+    addArgument(parser, ArgParseArgument(ArgParseArgument::OUTPUT_FILE, "GFF FILE"));
+    setValidValues(parser, 1, "gff");
+}
+
+int convertMain(int argc, char const * argv[])
+{
+    ArgumentParser parser("stellar convert");
+    _setConvertParser(parser);
+
+    ArgumentParser::ParseResult const res = parse(parser, argc, argv);
+    if (res != ArgumentParser::PARSE_OK)
+        return res == ArgumentParser::PARSE_ERROR;
+
+    CharString binaryFileName;
+    CharString gffFileName;
+    getArgumentValue(binaryFileName, parser, 0);
+    getArgumentValue(gffFileName, parser, 1);
+
+    std::ifstream binaryFile(toCString(binaryFileName), std::ios_base::in | std::ios_base::binary);
+    if (!binaryFile.is_open())
+    {
+        std::cerr << "Could not open binary match file." << std::endl;
+        return 1;
+    }
+
+    std::ofstream gffFile(toCString(gffFileName), std::ios_base::out);
+    if (!gffFile.is_open())
+    {
+        std::cerr << "Could not open output file." << std::endl;
+        return 1;
+    }
+
+    return _convertBinaryMatchesToGff(binaryFile, gffFile) ? 0 : 1;
+}
+
+} // namespace stellar::app
+
+} // namespace stellar
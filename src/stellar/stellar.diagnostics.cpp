@@ -28,6 +28,21 @@ void _writeCalculatedParams(StellarOptions & options)
     std::cout << std::endl;
 }
 
+///////////////////////////////////////////////////////////////////////////////
+// Writes the parameters that depend on the auto-tuned k-mer length to std::cout
+void _writeAutoTunedParams(StellarOptions const & options)
+{
+    StellarStatistics statistics{options};
+
+    std::cout << "Auto-tuned parameters:" << std::endl;
+    std::cout << "  k-mer length : " << statistics.kMerLength << std::endl;
+    std::cout << "  threshold    : " << statistics.threshold << std::endl;
+    std::cout << "  distance cut : " << statistics.distanceCut << std::endl;
+    std::cout << "  delta        : " << statistics.delta << std::endl;
+    std::cout << "  overlap      : " << statistics.overlap << std::endl;
+    std::cout << std::endl;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // Writes user specified parameters from options object to std::cout
 void _writeSpecifiedParams(StellarOptions const & options)
@@ -40,11 +55,15 @@ void _writeSpecifiedParams(StellarOptions const & options)
     std::cout << "  maximal x-drop                   : " << options.xDrop << std::endl;
     if (options.qGram != (unsigned)-1)
         std::cout << "  k-mer (q-gram) length            : " << options.qGram << std::endl;
+    if (options.autoTuneQGram)
+        std::cout << "  auto-tune k-mer length           : yes" << std::endl;
     std::cout << "  search forward strand            : " << ((options.forward) ? "yes" : "no") << std::endl;
     std::cout << "  search reverse complement        : " << ((options.reverse) ? "yes" : "no") << std::endl;
     std::cout << std::endl;
 
     std::cout << "  verification strategy            : " << to_string(options.verificationMethod) << std::endl;
+    if (options.precheck)
+        std::cout << "  verification precheck            : yes" << std::endl;
     if (options.disableThresh != (unsigned)-1)
     {
         std::cout << "  disable queries with more than   : " << options.disableThresh << " matches" << std::endl;
@@ -61,6 +80,8 @@ void _writeSpecifiedParams(StellarOptions const & options)
         std::cout << "  q-gram abundance cut ratio       : " << options.qgramAbundanceCut << std::endl;
     }
     std::cout << "  threads                          : " << options.threadCount << std::endl;
+    if (options.finderCount != 1)
+        std::cout << "  SWIFT finders per sequence       : " << options.finderCount << std::endl;
     std::cout << std::endl;
 }
 
@@ -75,10 +96,22 @@ void _writeFileNames(StellarOptions const & options)
     std::cout << "  alphabet        : " << options.alphabet << std::endl;
     std::cout << "  output file     : " << options.outputFile << std::endl;
     std::cout << "  output format   : " << options.outputFormat << std::endl;
+    if (options.compressOutput)
+    {
+        std::cout << "  compression     : bgzf" << std::endl;
+    }
     if (options.disableThresh != (unsigned)-1)
     {
         std::cout << "  disabled queries: " << options.disabledQueriesFile << std::endl;
     }
+    if (!empty(options.hitReportFile))
+    {
+        std::cout << "  hit report      : " << options.hitReportFile << std::endl;
+    }
+    if (options.streamOutput)
+    {
+        std::cout << "  streaming output: yes" << std::endl;
+    }
     std::cout << std::endl;
 }
 
@@ -101,6 +134,8 @@ void _printStellarKernelStatistics(StellarComputeStatistics const & statistics)
         return;
 
     std::cout << std::endl << "    # SWIFT hits      : " << statistics.numSwiftHits;
+    if (statistics.numRejectedSwiftHits != 0)
+        std::cout << std::endl << "    # Rejected hits   : " << statistics.numRejectedSwiftHits;
     std::cout << std::endl << "    Longest hit       : " << statistics.maxLength;
     std::cout << std::endl << "    Avg hit length    : " << statistics.totalLength/statistics.numSwiftHits;
 }
@@ -1,5 +1,8 @@
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <random>
+
 #include <stellar/stellar_extension.hpp>
 #include <stellar/extension/extension_banded_trace_matrix.hpp>
 
@@ -125,3 +128,339 @@ TEST(align_banded_nw_best_ends, sameTraceMatrixButDifferentParameters)
 
     expect_same_matrix(traceBackMatrix1, traceBackMatrix2);
 }
+
+TEST(align_banded_nw_best_ends, antidiagonalKernelMatchesRowwiseKernel)
+{
+    std::mt19937 rng{42u};
+
+    auto randomSequence = [&](size_t const sequenceLength)
+    {
+        seqan::String<seqan::Dna> sequence{};
+        for (size_t i = 0; i < sequenceLength; ++i)
+            appendValue(sequence, seqan::Dna{rng() % 4});
+        return sequence;
+    };
+
+    // mutates about every tenth position, such that the best ends are long alignments
+    auto mutatedSequence = [&](seqan::String<seqan::Dna> const & sequence)
+    {
+        seqan::String<seqan::Dna> mutated{};
+        for (size_t i = 0; i < length(sequence); ++i)
+        {
+            switch (rng() % 30)
+            {
+                case 0: appendValue(mutated, seqan::Dna{rng() % 4}); break; // substitution
+                case 1: break; // deletion
+                case 2: appendValue(mutated, seqan::Dna{rng() % 4}); appendValue(mutated, sequence[i]); break;
+                default: appendValue(mutated, sequence[i]);
+            }
+        }
+        return mutated;
+    };
+
+    for (size_t iteration = 0; iteration < 200u; ++iteration)
+    {
+        seqan::String<seqan::Dna> sequence1 = randomSequence(rng() % 300);
+        seqan::String<seqan::Dna> sequence2 = (iteration % 4 == 0) ? randomSequence(rng() % 300)
+                                                                   : mutatedSequence(sequence1);
+
+        seqan::StringSet<seqan::String<seqan::Dna>> sequences;
+        appendValue(sequences, sequence1);
+        appendValue(sequences, sequence2);
+
+        TDiagonal const diagL = -static_cast<TDiagonal>(rng() % 80);
+        TDiagonal const diagU = static_cast<TDiagonal>(rng() % 80);
+        TScore const errorScore = -static_cast<TScore>(1 + rng() % 20);
+        seqan::Score<TScore> scoringScheme(1, errorScore, errorScore);
+
+        // cells outside of the band are not written
+        seqan::String<seqan::TraceBack> trace1, trace2;
+        resize(trace1, (length(sequence2) + 1) * (diagU - diagL + 1), seqan::TraceBack{3});
+        resize(trace2, (length(sequence2) + 1) * (diagU - diagL + 1), seqan::TraceBack{3});
+        seqan::String<TEndInfo> possibleEnds1, possibleEnds2;
+        stellar::AlignBandedNwBestEndsBuffers<TScore> buffers1, buffers2;
+
+        stellar::_align_banded_nw_best_ends_rowwise(trace1, possibleEnds1, sequences, scoringScheme, diagL, diagU,
+                                                    buffers1);
+        stellar::_align_banded_nw_best_ends_antidiagonal(trace2, possibleEnds2, sequences, scoringScheme, diagL, diagU,
+                                                         buffers2);
+
+        ASSERT_EQ(length(trace1), length(trace2)) << "Iteration: " << iteration;
+        EXPECT_TRUE(std::equal(begin(trace1), end(trace1), begin(trace2))) << "Iteration: " << iteration;
+
+        ASSERT_EQ(length(possibleEnds1), length(possibleEnds2)) << "Iteration: " << iteration;
+        for (size_t errors = 0; errors < length(possibleEnds1); ++errors)
+        {
+            EXPECT_EQ(possibleEnds1[errors].length, possibleEnds2[errors].length) << "Errors: " << errors;
+            EXPECT_EQ(possibleEnds1[errors].coord, possibleEnds2[errors].coord) << "Errors: " << errors;
+        }
+    }
+}
+
+TEST(align_banded_nw_best_ends, packedTraceMatchesByteTrace)
+{
+    seqan::String<seqan::Dna> sequence1 = "TGTCAGCGGATGGGATGGTTCGTAATGGTAGTGGATTGCCCTTTGGAGTTAAATTACTTCTGCTCTGACACAATAGATCGG";
+    seqan::String<seqan::Dna> sequence2 = "TGTCAGCGGATGGATGGTTCGTAATGGTAGTGCATTGCCCTTTGGAGTTAAATTACTTCTGCTCTGACACAATAGATCGG";
+
+    seqan::StringSet<seqan::String<seqan::Dna>> sequences;
+    appendValue(sequences, sequence1);
+    appendValue(sequences, sequence2);
+
+    seqan::Score<TScore> scoringScheme(1, -19, -19);
+    size_t const rowCount = length(sequence2) + 1;
+    size_t const columnCount = length(sequence1) + 1;
+
+    // the narrow band uses the row-wise kernel, the wide band the anti-diagonal kernel
+    for (auto [diagL, diagU] : {std::pair<TDiagonal, TDiagonal>{-3, 2}, std::pair<TDiagonal, TDiagonal>{-40, 40}})
+    {
+        TTraceBackMatrix traceBackMatrix(rowCount, columnCount, diagL, diagU);
+        stellar::extension_packed_banded_trace_matrix packedTraceBackMatrix(rowCount, columnCount, diagL, diagU);
+        seqan::String<TEndInfo> possibleEnds, packedPossibleEnds;
+
+        _align_banded_nw_best_ends(traceBackMatrix.underlyingTraceMatrix(), possibleEnds, sequences, scoringScheme,
+                                   diagL, diagU);
+        _align_banded_nw_best_ends(packedTraceBackMatrix.underlyingTraceMatrix(), packedPossibleEnds, sequences,
+                                   scoringScheme, diagL, diagU);
+
+        // the kernels don't write the trace of the first row and column
+        auto [beginRow, endRow] = traceBackMatrix.rowInterval();
+        for (size_t row = std::max<size_t>(beginRow, 1u); row < endRow; ++row)
+        {
+            size_t const skip = (traceBackMatrix.columnIntervalInRow(row).first == 0u) ? 1u : 0u;
+            std::vector<int> const trace = actualTraceData(traceBackMatrix.rowSpan(row));
+            std::vector<int> const packedTrace = actualTraceData(packedTraceBackMatrix.rowSpan(row));
+            ASSERT_EQ(trace.size(), packedTrace.size());
+            EXPECT_TRUE(std::equal(trace.begin() + skip, trace.end(), packedTrace.begin() + skip)) << "Row: " << row;
+        }
+
+        ASSERT_EQ(length(possibleEnds), length(packedPossibleEnds));
+        for (size_t errors = 0; errors < length(possibleEnds); ++errors)
+            EXPECT_EQ(possibleEnds[errors].coord, packedPossibleEnds[errors].coord) << "Errors: " << errors;
+    }
+}
+
+TEST(align_banded_nw_best_ends, scoreOnlyPassAndRecomputedTrace)
+{
+    seqan::String<seqan::Dna> sequence1 =
+        "TGTCAGCGGATGGGATGGTTCGTAATGGTAGTGGATTGCCCTTTGGAGTTAAATTACTTCTGCTCTGACACAATAGATCGGTTTAATGACCATTCTCCGCTCACGCTAGA";
+    seqan::String<seqan::Dna> sequence2 =
+        "TGTCAGCGGATGGATGGTTCGTAATGGTAGTGCATTGCCCTTTGGAGTTAAATTACTTCTGCTCTGACACAATAGATCGGTTTAATGACCATTCTCCCTCACGCTAGA";
+
+    seqan::StringSet<seqan::String<seqan::Dna>> sequences;
+    appendValue(sequences, sequence1);
+    appendValue(sequences, sequence2);
+
+    seqan::Score<TScore> scoringScheme(1, -19, -19);
+
+    for (auto [diagL, diagU] : {std::pair<TDiagonal, TDiagonal>{-3, 2}, std::pair<TDiagonal, TDiagonal>{-40, 40}})
+    {
+        // first pass: only the best ends
+        stellar::extension_score_only_trace scoreOnlyTrace{};
+        seqan::String<TEndInfo> scoreOnlyPossibleEnds;
+        _align_banded_nw_best_ends(scoreOnlyTrace, scoreOnlyPossibleEnds, sequences, scoringScheme, diagL, diagU);
+
+        seqan::String<seqan::TraceBack> trace;
+        seqan::String<TEndInfo> possibleEnds;
+        _align_banded_nw_best_ends(trace, possibleEnds, sequences, scoringScheme, diagL, diagU);
+
+        ASSERT_EQ(length(scoreOnlyPossibleEnds), length(possibleEnds));
+        for (size_t errors = 0; errors < length(possibleEnds); ++errors)
+        {
+            EXPECT_EQ(scoreOnlyPossibleEnds[errors].length, possibleEnds[errors].length) << "Errors: " << errors;
+            EXPECT_EQ(scoreOnlyPossibleEnds[errors].coord, possibleEnds[errors].coord) << "Errors: " << errors;
+        }
+
+        // second pass: the trace of the sub-rectangle of each end gives the same traceback
+        size_t const lo_row = (diagU <= 0) ? -diagU : 0;
+        for (TEndInfo const & end : possibleEnds)
+        {
+            size_t const endRow = end.coord.i1 + lo_row;
+            size_t const endColumn = end.coord.i2 + diagL + endRow;
+
+            seqan::StringSet<seqan::String<seqan::Dna>> prefixes;
+            appendValue(prefixes, prefix(sequence1, endColumn));
+            appendValue(prefixes, prefix(sequence2, endRow));
+
+            stellar::extension_packed_trace recomputedTrace{};
+            seqan::String<TEndInfo> recomputedPossibleEnds;
+            _align_banded_nw_best_ends(recomputedTrace, recomputedPossibleEnds, prefixes, scoringScheme, diagL, diagU);
+
+            seqan::AlignTraceback<size_t> traceBack, recomputedTraceBack;
+            stellar::_alignBandedNeedlemanWunschTrace(traceBack, sequences, trace, end.coord, diagL, diagU);
+            stellar::_alignBandedNeedlemanWunschTrace(recomputedTraceBack, prefixes, recomputedTrace, end.coord,
+                                                      diagL, diagU);
+
+            EXPECT_TRUE(traceBack.sizes == recomputedTraceBack.sizes) << "Length: " << end.length;
+            EXPECT_TRUE(traceBack.tvs == recomputedTraceBack.tvs) << "Length: " << end.length;
+        }
+    }
+}
+
+TEST(align_banded_nw_best_ends, xdropKernelWithoutDropsMatchesRowwiseKernel)
+{
+    std::mt19937 rng{7u};
+
+    auto randomSequence = [&](size_t const sequenceLength)
+    {
+        seqan::String<seqan::Dna> sequence{};
+        for (size_t i = 0; i < sequenceLength; ++i)
+            appendValue(sequence, seqan::Dna{rng() % 4});
+        return sequence;
+    };
+
+    for (size_t iteration = 0; iteration < 200u; ++iteration)
+    {
+        seqan::String<seqan::Dna> sequence1 = randomSequence(rng() % 300);
+        seqan::String<seqan::Dna> sequence2 = randomSequence(rng() % 300);
+
+        seqan::StringSet<seqan::String<seqan::Dna>> sequences;
+        appendValue(sequences, sequence1);
+        appendValue(sequences, sequence2);
+
+        TDiagonal const diagL = -static_cast<TDiagonal>(rng() % 80);
+        TDiagonal const diagU = static_cast<TDiagonal>(rng() % 80);
+        TScore const errorScore = -static_cast<TScore>(1 + rng() % 20);
+        seqan::Score<TScore> scoringScheme(1, errorScore, errorScore);
+
+        // the smallest drop-off for which _align_banded_nw_best_ends_xdrop doesn't prune, no cell falls below the
+        // best score minus this drop-off
+        TScore const scoreDropOff = static_cast<TScore>(std::min(length(sequence1), length(sequence2)))
+                                  - static_cast<TScore>(std::max(length(sequence1), length(sequence2))) * errorScore;
+
+        seqan::String<seqan::TraceBack> trace1, trace2, trace3;
+        resize(trace1, (length(sequence2) + 1) * (diagU - diagL + 1), seqan::TraceBack{3});
+        resize(trace2, (length(sequence2) + 1) * (diagU - diagL + 1), seqan::TraceBack{3});
+        resize(trace3, (length(sequence2) + 1) * (diagU - diagL + 1), seqan::TraceBack{3});
+        seqan::String<TEndInfo> possibleEnds1, possibleEnds2, possibleEnds3;
+        stellar::AlignBandedNwBestEndsBuffers<TScore> buffers1, buffers2, buffers3;
+
+        stellar::_align_banded_nw_best_ends_rowwise(trace1, possibleEnds1, sequences, scoringScheme, diagL, diagU,
+                                                    buffers1);
+        stellar::_align_banded_nw_best_ends_xdrop_rowwise(trace2, possibleEnds2, sequences, scoringScheme, diagL, diagU,
+                                                          scoreDropOff, buffers2);
+        stellar::_align_banded_nw_best_ends_xdrop(trace3, possibleEnds3, sequences, scoringScheme, diagL, diagU,
+                                                  scoreDropOff, buffers3);
+
+        ASSERT_EQ(length(trace1), length(trace2)) << "Iteration: " << iteration;
+        EXPECT_TRUE(std::equal(begin(trace1), end(trace1), begin(trace2))) << "Iteration: " << iteration;
+        ASSERT_EQ(length(trace1), length(trace3)) << "Iteration: " << iteration;
+        EXPECT_TRUE(std::equal(begin(trace1), end(trace1), begin(trace3))) << "Iteration: " << iteration;
+
+        ASSERT_EQ(length(possibleEnds1), length(possibleEnds2)) << "Iteration: " << iteration;
+        ASSERT_EQ(length(possibleEnds1), length(possibleEnds3)) << "Iteration: " << iteration;
+        for (size_t errors = 0; errors < length(possibleEnds1); ++errors)
+        {
+            EXPECT_EQ(possibleEnds1[errors].length, possibleEnds2[errors].length) << "Errors: " << errors;
+            EXPECT_EQ(possibleEnds1[errors].coord, possibleEnds2[errors].coord) << "Errors: " << errors;
+            EXPECT_EQ(possibleEnds1[errors].length, possibleEnds3[errors].length) << "Errors: " << errors;
+            EXPECT_EQ(possibleEnds1[errors].coord, possibleEnds3[errors].coord) << "Errors: " << errors;
+        }
+    }
+}
+
+TEST(align_banded_nw_best_ends, xdropKernelKeepsMatchOfIdenticalSequences)
+{
+    seqan::String<seqan::Dna> sequence =
+        "TGTCAGCGGATGGGATGGTTCGTAATGGTAGTGGATTGCCCTTTGGAGTTAAATTACTTCTGCTCTGACACAATAGATCGGTTTAATGACCATTCTCCGCTCACGCTAGA";
+
+    seqan::StringSet<seqan::String<seqan::Dna>> sequences;
+    appendValue(sequences, sequence);
+    appendValue(sequences, sequence);
+
+    seqan::Score<TScore> scoringScheme(1, -19, -19);
+    TDiagonal const diagL = -100;
+    TDiagonal const diagU = 100;
+
+    seqan::String<seqan::TraceBack> trace;
+    seqan::String<TEndInfo> possibleEnds;
+    stellar::AlignBandedNwBestEndsBuffers<TScore> buffers;
+    stellar::_align_banded_nw_best_ends_xdrop(trace, possibleEnds, sequences, scoringScheme, diagL, diagU,
+                                              TScore{5 * 19}, buffers);
+
+    // the error-free end is the whole main diagonal
+    ASSERT_FALSE(empty(possibleEnds));
+    EXPECT_EQ(possibleEnds[0].length, length(sequence));
+    EXPECT_EQ(possibleEnds[0].coord.i1, length(sequence) + 0u);
+    EXPECT_EQ(possibleEnds[0].coord.i2, static_cast<size_t>(-diagL));
+
+    seqan::AlignTraceback<size_t> traceBack;
+    stellar::_alignBandedNeedlemanWunschTrace(traceBack, sequences, trace, possibleEnds[0].coord, diagL, diagU);
+    ASSERT_EQ(length(traceBack.sizes), 1u);
+    EXPECT_EQ(traceBack.sizes[0], length(sequence));
+    EXPECT_EQ(traceBack.tvs[0], seqan::TraceBack{0});
+}
+
+TEST(align_banded_nw_best_ends, unitMatchScoreMatchesScore)
+{
+    std::mt19937 rng{11u};
+
+    auto randomSequence = [&](size_t const sequenceLength)
+    {
+        seqan::String<seqan::Dna> sequence{};
+        for (size_t i = 0; i < sequenceLength; ++i)
+            appendValue(sequence, seqan::Dna{rng() % 4});
+        return sequence;
+    };
+
+    auto expectSameEnds = [](seqan::String<TEndInfo> const & possibleEnds1, seqan::String<TEndInfo> const & possibleEnds2)
+    {
+        ASSERT_EQ(length(possibleEnds1), length(possibleEnds2));
+        for (size_t errors = 0; errors < length(possibleEnds1); ++errors)
+        {
+            EXPECT_EQ(possibleEnds1[errors].length, possibleEnds2[errors].length) << "Errors: " << errors;
+            EXPECT_EQ(possibleEnds1[errors].coord, possibleEnds2[errors].coord) << "Errors: " << errors;
+        }
+    };
+
+    for (size_t iteration = 0; iteration < 100u; ++iteration)
+    {
+        seqan::StringSet<seqan::String<seqan::Dna>> sequences;
+        appendValue(sequences, randomSequence(rng() % 200));
+        appendValue(sequences, randomSequence(rng() % 200));
+
+        TDiagonal const diagL = -static_cast<TDiagonal>(rng() % 60);
+        TDiagonal const diagU = static_cast<TDiagonal>(rng() % 60);
+        TScore const errorScore = -static_cast<TScore>(1 + rng() % 20);
+        seqan::Score<TScore> const scoringScheme(1, errorScore, errorScore);
+        stellar::UnitMatchScore<TScore> const unitMatchScore = stellar::_unitMatchScore(scoringScheme);
+        EXPECT_EQ(scoreMatch(unitMatchScore), 1);
+        EXPECT_EQ(scoreGap(unitMatchScore), errorScore);
+
+        // cells outside of the band are not written
+        seqan::String<seqan::TraceBack> trace1, trace2;
+        auto resetTraces = [&]()
+        {
+            clear(trace1);
+            clear(trace2);
+            resize(trace1, (length(sequences[1]) + 1) * (diagU - diagL + 1), seqan::TraceBack{3});
+            resize(trace2, (length(sequences[1]) + 1) * (diagU - diagL + 1), seqan::TraceBack{3});
+        };
+        seqan::String<TEndInfo> possibleEnds1, possibleEnds2;
+        stellar::AlignBandedNwBestEndsBuffers<TScore> buffers;
+
+        resetTraces();
+        stellar::_align_banded_nw_best_ends_rowwise(trace1, possibleEnds1, sequences, scoringScheme, diagL, diagU,
+                                                    buffers);
+        stellar::_align_banded_nw_best_ends_rowwise(trace2, possibleEnds2, sequences, unitMatchScore, diagL, diagU,
+                                                    buffers);
+        EXPECT_TRUE(trace1 == trace2) << "Iteration: " << iteration;
+        expectSameEnds(possibleEnds1, possibleEnds2);
+
+        resetTraces();
+        stellar::_align_banded_nw_best_ends_antidiagonal(trace1, possibleEnds1, sequences, scoringScheme, diagL, diagU,
+                                                         buffers);
+        stellar::_align_banded_nw_best_ends_antidiagonal(trace2, possibleEnds2, sequences, unitMatchScore, diagL, diagU,
+                                                         buffers);
+        EXPECT_TRUE(trace1 == trace2) << "Iteration: " << iteration;
+        expectSameEnds(possibleEnds1, possibleEnds2);
+
+        resetTraces();
+        TScore const scoreDropOff = 5 * -errorScore;
+        stellar::_align_banded_nw_best_ends_xdrop_rowwise(trace1, possibleEnds1, sequences, scoringScheme, diagL, diagU,
+                                                          scoreDropOff, buffers);
+        stellar::_align_banded_nw_best_ends_xdrop_rowwise(trace2, possibleEnds2, sequences, unitMatchScore, diagL, diagU,
+                                                          scoreDropOff, buffers);
+        EXPECT_TRUE(trace1 == trace2) << "Iteration: " << iteration;
+        expectSameEnds(possibleEnds1, possibleEnds2);
+    }
+}
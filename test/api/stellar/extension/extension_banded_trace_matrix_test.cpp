@@ -230,3 +230,36 @@ TEST(extension_banded_trace_matrix, rowSpan)
         EXPECT_EQ(actualTraceData(matrix.rowSpan(5)), (std::vector<int>{}));
     }
 }
+
+TEST(extension_packed_banded_trace_matrix, rowSpan)
+{
+    auto actualTraceData = [](auto const & data)
+    {
+        return std::vector<int>(data.begin(), data.end());
+    };
+
+    stellar::extension_packed_banded_trace_matrix matrix{/*rows*/ 5u, /*columns*/ 5u, -2, +2};
+    EXPECT_EQ(matrix.dataSize(), 5 * 5);
+    EXPECT_EQ(matrix.data().size(), 5 * 5);
+    EXPECT_LE(matrix.underlyingTraceMatrix().byteSize(), 8u); // 25 cells with 2 bits fit into one word
+
+    // trace values are 2 bit: 0, 1, 2, 0, 1, 2, ...
+    for (size_t position = 0; position < matrix.dataSize(); ++position)
+        stellar::_assignTraceValue(matrix.underlyingTraceMatrix(), position, seqan::TraceBack(position % 3));
+
+    //      ||e|A|B|C|D||
+    // e|0|1||2|0|1|x|x||
+    EXPECT_EQ(actualTraceData(matrix.rowSpan(0)), (std::vector<int>{2, 0, 1}));
+    // A  |2||0|1|2|0|x||
+    EXPECT_EQ(actualTraceData(matrix.rowSpan(1)), (std::vector<int>{0, 1, 2, 0}));
+    // B    ||1|2|0|1|2||
+    EXPECT_EQ(actualTraceData(matrix.rowSpan(2)), (std::vector<int>{1, 2, 0, 1, 2}));
+    // C    ||x|0|1|2|0||1|
+    EXPECT_EQ(actualTraceData(matrix.rowSpan(3)), (std::vector<int>{0, 1, 2, 0}));
+    // D    ||x|x|2|0|1||2|0|
+    EXPECT_EQ(actualTraceData(matrix.rowSpan(4)), (std::vector<int>{2, 0, 1}));
+
+    // overwriting a cell keeps its neighbours
+    stellar::_assignTraceValue(matrix.underlyingTraceMatrix(), 11u, seqan::TraceBack{0});
+    EXPECT_EQ(actualTraceData(matrix.rowSpan(2)), (std::vector<int>{1, 0, 0, 1, 2}));
+}
@@ -1,5 +1,7 @@
 #include <gtest/gtest.h>
 
+#include <random>
+
 #include <stellar/stellar_extension.hpp>
 
 using TExtensionEndPosition = stellar::ExtensionEndPosition<size_t>;
@@ -214,3 +216,84 @@ TEST(longestEpsMatch, multipleValidEpsMatches)
     EXPECT_EQ(endPositionPair.i1 - begin(leftExtensions), 1);
     EXPECT_EQ(endPositionPair.i2 - begin(rightExtensions), 6);
 }
+
+// the former implementation of longestEpsMatch, which tests all combinations of left and right ends
+TPair longestEpsMatchAllCombinations(seqan::String<TExtensionEndPosition> const & possEndsLeft,
+                                     seqan::String<TExtensionEndPosition> const & possEndsRight,
+                                     size_t const alignLen,
+                                     size_t const alignErr,
+                                     size_t const matchMinLength,
+                                     double const epsilon)
+{
+    using TIterator = typename seqan::Iterator<seqan::String<TExtensionEndPosition> const>::Type;
+
+    TIterator rightIt = end(possEndsRight) - 1;
+    TIterator leftIt = end(possEndsLeft) - 1;
+    TIterator right = begin(possEndsRight);
+    TIterator left = begin(possEndsLeft);
+    size_t leftErr = length(possEndsLeft) - 1;
+    size_t minLength = matchMinLength;
+    bool found = false;
+    double const DELTA = 0.000001;
+
+    while (leftIt >= begin(possEndsLeft)) {
+        size_t totalLen = (*leftIt).length + alignLen + (*rightIt).length;
+        if (totalLen < minLength) break;
+        size_t totalErr = leftErr + alignErr + length(possEndsRight) - 1;
+        while (rightIt >= begin(possEndsRight)) {
+            totalLen = (*leftIt).length + alignLen + (*rightIt).length;
+            if (totalLen < minLength) break;
+            if ((double)totalErr/(double)totalLen < epsilon + DELTA) {
+                right = rightIt;
+                left = leftIt;
+                minLength = totalLen;
+                found = true;
+                break;
+            }
+            --rightIt;
+            --totalErr;
+        }
+        rightIt = end(possEndsRight) - 1;
+        --leftIt;
+        --leftErr;
+    }
+
+    return found ? TPair(left, right) : TPair(0, 0);
+}
+
+TEST(longestEpsMatch, sameAsAllCombinations)
+{
+    std::mt19937 rng{42u};
+    stellar::LongestEpsMatchScratch<size_t> scratch{};
+
+    for (size_t iteration = 0; iteration < 20000u; ++iteration)
+    {
+        // best ends are usually increasing in length, but this is not required
+        bool const increasing = iteration % 4 != 0;
+        auto randomEnds = [&]()
+        {
+            seqan::String<TExtensionEndPosition> ends{};
+            size_t endLength = 0;
+            for (size_t errors = 0, count = 1 + rng() % 40; errors < count; ++errors)
+            {
+                endLength = increasing ? endLength + rng() % 10 : rng() % 300;
+                appendValue(ends, TExtensionEndPosition{endLength, errors, errors});
+            }
+            return ends;
+        };
+
+        seqan::String<TExtensionEndPosition> leftExtensions = randomEnds();
+        seqan::String<TExtensionEndPosition> rightExtensions = randomEnds();
+        size_t const seedLength = rng() % 150;
+        size_t const seedError = rng() % 10;
+        size_t const minLength = rng() % 300;
+        double const epsilon = (rng() % 200) / 1000.0; // includes error rates that are exactly epsilon
+
+        TPair const expected = longestEpsMatchAllCombinations(leftExtensions, rightExtensions, seedLength, seedError,
+                                                              minLength, epsilon);
+        TPair const actual = stellar::longestEpsMatch(leftExtensions, rightExtensions, seedLength, seedError,
+                                                      minLength, epsilon, scratch);
+
+        ASSERT_TRUE(expected == actual) << "Iteration: " << iteration;
+    }
+}
@@ -0,0 +1,158 @@
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <limits>
+#include <sstream>
+#include <string>
+
+#include <stellar/stellar_binary_output.hpp>
+
+#include <stellar/test/fixture/stellar_match_fixture.hpp>
+
+using TAlphabet = stellar::test::stellar_match_fixture::TAlphabet;
+using TMatch = stellar::test::stellar_match_fixture::TMatch;
+using TQueryMatches = stellar::QueryMatches<TMatch>;
+
+struct StellarBinaryOutputTest : public stellar::test::stellar_match_fixture
+{
+    void SetUp() override
+    {
+        stellar::test::stellar_match_fixture::SetUp();
+
+        appendValue(databaseIDs, "db0 first");
+        appendValue(databaseIDs, "db1\tsecond");
+        appendValue(queryIDs, "query0 some description");
+        appendValue(queryIDs, "query1");
+        appendValue(queryIDs, "query2");
+
+        resize(matches, 3);
+        for (size_t queryID : {0u, 2u})
+        {
+            TQueryMatches & queryMatches = matches[queryID];
+            queryMatches.lengthAdjustment = 2u;
+            appendValue(queryMatches.matches, countedMatch(align, 1u, true, queryMatches.editScripts));
+            appendValue(queryMatches.matches, countedMatch(align, 0u, false, queryMatches.editScripts));
+            appendValue(queryMatches.matches, countedMatch(align, 0u, true, queryMatches.editScripts));
+        }
+    }
+
+    // the gff file written by _writeQueryMatchesToFile, first the forward then the reverse strand
+    std::string expectedGff() const
+    {
+        std::stringstream gffFile;
+        for (bool orientation : {true, false})
+            for (size_t queryID = 0; queryID < length(matches); ++queryID)
+                stellar::_writeQueryMatchesToFile(matches[queryID], databaseIDs, queryIDs[queryID], orientation,
+                                                  "gff", gffFile);
+        return gffFile.str();
+    }
+
+    seqan::StringSet<seqan::CharString> databaseIDs{};
+    seqan::StringSet<seqan::CharString> queryIDs{};
+    seqan::StringSet<TQueryMatches> matches{};
+};
+
+TEST_F(StellarBinaryOutputTest, editRun)
+{
+    for (stellar::StellarEditRun const editRun : {stellar::StellarEditRun{stellar::StellarEditRun::aligned, 1u},
+                                                  stellar::StellarEditRun{stellar::StellarEditRun::deletion, 7u},
+                                                  stellar::StellarEditRun{stellar::StellarEditRun::insertion,
+                                                                          stellar::StellarEditRun::maxCount}})
+    {
+        stellar::StellarEditRun const decoded = stellar::_decodeBinaryEditRun(stellar::_encodeBinaryEditRun(editRun));
+        EXPECT_EQ(decoded.kind, editRun.kind);
+        EXPECT_EQ(decoded.count, editRun.count);
+    }
+}
+
+TEST_F(StellarBinaryOutputTest, convertToGff)
+{
+    std::stringstream binaryFile;
+    stellar::_writeBinaryMatchesHeader<TAlphabet>(databaseIDs, queryIDs, binaryFile);
+    stellar::_writeAllQueryMatchesToBinaryFile(matches, true, binaryFile);
+    stellar::_writeAllQueryMatchesToBinaryFile(matches, false, binaryFile);
+
+    std::stringstream gffFile;
+    ASSERT_TRUE(stellar::_convertBinaryMatchesToGff(binaryFile, gffFile));
+    EXPECT_EQ(gffFile.str(), expectedGff());
+}
+
+TEST_F(StellarBinaryOutputTest, readHeader)
+{
+    std::stringstream binaryFile;
+    stellar::_writeBinaryMatchesHeader<TAlphabet>(databaseIDs, queryIDs, binaryFile);
+
+    stellar::StellarBinaryHeader header;
+    stellar::StellarBinaryStringTable binaryDatabaseIDs;
+    stellar::StellarBinaryStringTable binaryQueryIDs;
+    ASSERT_TRUE(stellar::_readBinaryMatchesHeader(binaryFile, header, binaryDatabaseIDs, binaryQueryIDs));
+
+    EXPECT_EQ(header.flags, stellar::StellarBinaryHeader::hasEValues);
+    ASSERT_EQ(binaryDatabaseIDs.size(), 2u);
+    EXPECT_EQ(binaryDatabaseIDs[0], "db0");
+    EXPECT_EQ(binaryDatabaseIDs[1], "db1");
+    ASSERT_EQ(binaryQueryIDs.size(), 3u);
+    EXPECT_EQ(binaryQueryIDs[0], "query0");
+    EXPECT_EQ(binaryQueryIDs[2], "query2");
+}
+
+TEST_F(StellarBinaryOutputTest, corruptFile)
+{
+    std::stringstream gffFile;
+
+    std::stringstream notBinaryFile{"db0\tStellar\teps-matches\t3\t9\t62.5\t+\t.\tquery0\n"};
+    EXPECT_FALSE(stellar::_convertBinaryMatchesToGff(notBinaryFile, gffFile));
+
+    std::stringstream binaryFile;
+    stellar::_writeBinaryMatchesHeader<TAlphabet>(databaseIDs, queryIDs, binaryFile);
+    stellar::_writeAllQueryMatchesToBinaryFile(matches, true, binaryFile);
+    std::string truncated = binaryFile.str();
+    truncated.resize(truncated.size() - 1u);
+
+    std::stringstream truncatedFile{truncated};
+    EXPECT_FALSE(stellar::_convertBinaryMatchesToGff(truncatedFile, gffFile));
+}
+
+TEST_F(StellarBinaryOutputTest, corruptCounts)
+{
+    std::stringstream gffFile;
+    uint64_t const maxCount = std::numeric_limits<uint64_t>::max();
+
+    // the counts of a string table and of a block exceed the file
+    for (uint64_t const count : {maxCount, maxCount / 8u})
+    {
+        std::stringstream binaryFile;
+        stellar::StellarBinaryHeader header{};
+        std::memcpy(header.magic, stellar::StellarBinaryHeader::fileMagic, sizeof(header.magic));
+        header.version = stellar::StellarBinaryHeader::fileVersion;
+        uint64_t const counts[2] = {count, 0u};
+        stellar::_writeBinary(binaryFile, &header, 1u);
+        stellar::_writeBinary(binaryFile, counts, 2u);
+        EXPECT_FALSE(stellar::_convertBinaryMatchesToGff(binaryFile, gffFile));
+    }
+
+    {
+        std::stringstream binaryFile;
+        stellar::_writeBinaryMatchesHeader<TAlphabet>(databaseIDs, queryIDs, binaryFile);
+        stellar::StellarBinaryBlockHeader const blockHeader{maxCount / 128u, 0u, 0u};
+        stellar::_writeBinary(binaryFile, &blockHeader, 1u);
+        EXPECT_FALSE(stellar::_convertBinaryMatchesToGff(binaryFile, gffFile));
+    }
+
+    // the edit runs and mutations of a match wrap around
+    for (bool const editRuns : {true, false})
+    {
+        stellar::StellarBinaryMatches block;
+        stellar::_appendBinaryMatch(block, 0u, matches[0].lengthAdjustment, matches[0].matches[0],
+                                    matches[0].editScripts);
+        if (editRuns)
+            block.matches[0].editRunsBegin = maxCount;
+        else
+            block.matches[0].mutationsBegin = maxCount;
+
+        std::stringstream binaryFile;
+        stellar::_writeBinaryMatchesHeader<TAlphabet>(databaseIDs, queryIDs, binaryFile);
+        stellar::_writeBinaryMatchesBlock(block, binaryFile);
+        EXPECT_FALSE(stellar::_convertBinaryMatchesToGff(binaryFile, gffFile));
+    }
+}
@@ -370,3 +370,46 @@ TEST(getDatabaseSegment, incorrect_indices)
         FAIL() << "Expected std::runtime_error";
     }
 }
+
+////////////////////////////////////////////////
+//  _partitionDatabaseSegment
+////////////////////////////////////////////////
+TEST(_partitionDatabaseSegment, ranges)
+{
+    seqan::String<TAlphabet> database;
+    resize(database, 1000u, TAlphabet{'A'});
+    TDatabaseSegment segment{database, 100u, 900u};
+
+    // the margin is rounded up to 64, ranges are 200 rounded up to 208
+    std::vector<stellar::StellarFinderRange<TAlphabet>> finderRanges
+        = stellar::_partitionDatabaseSegment(segment, 4u, 50u, 16u);
+
+    ASSERT_EQ(finderRanges.size(), 4u);
+    EXPECT_EQ(finderRanges[0].scanSegment, (TDatabaseSegment{database, 100u, 372u}));
+    EXPECT_EQ(finderRanges[0].rangeBegin, 100u);
+    EXPECT_EQ(finderRanges[0].rangeEnd, 308u);
+    EXPECT_EQ(finderRanges[1].scanSegment, (TDatabaseSegment{database, 244u, 580u}));
+    EXPECT_EQ(finderRanges[1].rangeBegin, 308u);
+    EXPECT_EQ(finderRanges[1].rangeEnd, 516u);
+    EXPECT_EQ(finderRanges[2].scanSegment, (TDatabaseSegment{database, 452u, 788u}));
+    EXPECT_EQ(finderRanges[2].rangeBegin, 516u);
+    EXPECT_EQ(finderRanges[2].rangeEnd, 724u);
+    EXPECT_EQ(finderRanges[3].scanSegment, (TDatabaseSegment{database, 660u, 900u}));
+    EXPECT_EQ(finderRanges[3].rangeBegin, 724u);
+    EXPECT_EQ(finderRanges[3].rangeEnd, 900u);
+}
+
+TEST(_partitionDatabaseSegment, segment_shorter_than_warm_up)
+{
+    seqan::String<TAlphabet> database;
+    resize(database, 1000u, TAlphabet{'A'});
+    TDatabaseSegment segment{database, 100u, 200u};
+
+    std::vector<stellar::StellarFinderRange<TAlphabet>> finderRanges
+        = stellar::_partitionDatabaseSegment(segment, 8u, 64u, 16u);
+
+    ASSERT_EQ(finderRanges.size(), 1u);
+    EXPECT_EQ(finderRanges[0].scanSegment, segment);
+    EXPECT_EQ(finderRanges[0].rangeBegin, 100u);
+    EXPECT_EQ(finderRanges[0].rangeEnd, 200u);
+}
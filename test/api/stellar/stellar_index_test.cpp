@@ -1,5 +1,10 @@
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <random>
+#include <utility>
+#include <vector>
+
 #include <stellar/stellar.hpp>
 
 struct StringSetOwnerFactory
@@ -131,7 +136,8 @@ struct SwiftHitVerifier<TVerifyPassthroughSeed>
                 StellarQuerySegment<TAlphabet> const & querySegment,
                 TDelta const delta,
                 TOnAlignmentResultFn && onAlignmentResult,
-                [[maybe_unused]] stellar_verification_time & verification_runtime)
+                [[maybe_unused]] stellar_verification_time & verification_runtime,
+                [[maybe_unused]] StellarVerificationContext<String<TAlphabet>> & verification_context)
     {
         onAlignmentResult(databaseSegment, querySegment, delta);
     }
@@ -388,3 +394,107 @@ TYPED_TEST(StellarIndexTest, validSeedWithOneErrorMatches)
     this->expect_segment(results.alignments[5].second, queries[5], 3u, 3u + 6u + 2u + 9u + 5u,
                          "CCAGTT" "TA" "GCAGAACAC" "CAAGA");
 }
+
+TEST(StellarKernelFinderRanges, sameSwiftHitsAsSingleFinder)
+{
+    using TAlphabet = seqan::Dna5;
+    using TSequence = seqan::String<TAlphabet>;
+    using TDatabaseSegment = stellar::StellarDatabaseSegment<TAlphabet>;
+    using TQuerySegment = stellar::StellarQuerySegment<TAlphabet>;
+    using TSwiftHit = std::pair<TDatabaseSegment, TQuerySegment>;
+
+    std::mt19937 randomEngine{42u};
+    auto randomBase = [&]() { return TAlphabet{"ACGT"[randomEngine() % 4u]}; };
+
+    TSequence database{};
+    for (size_t i = 0; i < 30000u; ++i)
+        appendValue(database, randomBase());
+    TDatabaseSegment const databaseSegment{database, 0u, length(database)};
+
+    stellar::StellarOptions options{};
+    options.qGram = 11u;
+    options.epsilon = {5, 100};
+    options.minLength = 100u;
+
+    size_t const maxQueryLength = 400u;
+    stellar::StellarStatistics const swiftStatistics{options};
+    std::vector<stellar::StellarFinderRange<TAlphabet>> const finderRanges
+        = stellar::_partitionDatabaseSegment(databaseSegment, 4u,
+                                             stellar::_finderRangeMargin(options, maxQueryLength),
+                                             swiftStatistics.delta);
+    ASSERT_EQ(finderRanges.size(), 4u);
+
+    // mutated copies of the database around each range boundary and inside of the ranges
+    seqan::StringSet<TSequence> queries{};
+    for (stellar::StellarFinderRange<TAlphabet> const & finderRange : finderRanges)
+    {
+        for (size_t const center : {finderRange.rangeBegin, (finderRange.rangeBegin + finderRange.rangeEnd) / 2u})
+        {
+            for (size_t const queryLength : {150u, 250u, 400u})
+            {
+                size_t const begin = std::max<size_t>(center, queryLength) - queryLength / 2u;
+                TSequence query = infix(database, begin, std::min<size_t>(begin + queryLength, length(database)));
+                for (size_t i = 0; i < length(query); ++i)
+                    if (randomEngine() % 50u == 0u)
+                        query[i] = randomBase();
+                appendValue(queries, query);
+            }
+        }
+    }
+
+    stellar::StellarIndex<TAlphabet> index{queries, options};
+    index.construct();
+
+    stellar::SwiftHitVerifier<stellar::TVerifyPassthroughSeed> verifier
+    {
+        STELLAR_DESIGNATED_INITIALIZER(.eps_match_options =, options),
+        STELLAR_DESIGNATED_INITIALIZER(.verifier_options =, options),
+    };
+    auto isQueryDisabled = [](TQuerySegment const &){ return false; };
+    auto onAlignmentResult = [](auto const & ...){};
+
+    auto collectSwiftHits = [](std::vector<TSwiftHit> & swiftHits)
+    {
+        return [&swiftHits](TDatabaseSegment const & databaseSegment, TQuerySegment const & querySegment, bool,
+                            stellar::stellar_runtime::duration_t)
+        {
+            swiftHits.emplace_back(databaseSegment, querySegment);
+        };
+    };
+
+    std::vector<TSwiftHit> expectedSwiftHits{};
+    {
+        stellar::StellarSwiftPattern<TAlphabet> swiftPattern = index.createSwiftPattern();
+        stellar::StellarSwiftFinder<TAlphabet> swiftFinder{databaseSegment.asInfixSegment(), options.minRepeatLength,
+                                                           options.maxRepeatPeriod};
+        stellar::stellar_kernel_runtime kernel_runtime{};
+        stellar::_stellarKernel(swiftFinder, swiftPattern, verifier, isQueryDisabled, onAlignmentResult,
+                                collectSwiftHits(expectedSwiftHits), kernel_runtime);
+    }
+
+    std::vector<TSwiftHit> swiftHits{};
+    {
+        stellar::StellarSwiftPattern<TAlphabet> swiftPattern = index.createSwiftPattern();
+        stellar::stellar_kernel_runtime kernel_runtime{};
+        stellar::StellarComputeStatistics const statistics
+            = stellar::_stellarKernel(finderRanges, options.minRepeatLength, options.maxRepeatPeriod, swiftPattern,
+                                      verifier, isQueryDisabled, onAlignmentResult, collectSwiftHits(swiftHits),
+                                      kernel_runtime);
+        EXPECT_EQ(statistics.numSwiftHits, swiftHits.size());
+    }
+
+    // some swift hits cross a range boundary
+    auto crossesRangeBoundary = [&](TSwiftHit const & swiftHit)
+    {
+        return std::any_of(finderRanges.begin() + 1, finderRanges.end(), [&](auto const & finderRange)
+        {
+            return swiftHit.first.beginPosition() < finderRange.rangeBegin &&
+                   finderRange.rangeBegin < swiftHit.first.endPosition();
+        });
+    };
+    EXPECT_TRUE(std::any_of(expectedSwiftHits.begin(), expectedSwiftHits.end(), crossesRangeBoundary));
+
+    std::sort(expectedSwiftHits.begin(), expectedSwiftHits.end());
+    std::sort(swiftHits.begin(), swiftHits.end());
+    EXPECT_EQ(swiftHits, expectedSwiftHits);
+}
@@ -0,0 +1,326 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <vector>
+
+#include <stellar/stellar.hpp>
+#include <stellar/stellar_output.hpp>
+
+#include <stellar/test/fixture/stellar_match_fixture.hpp>
+
+using TAlphabet = stellar::test::stellar_match_fixture::TAlphabet;
+using TSequence = stellar::test::stellar_match_fixture::TSequence;
+using TMatch = stellar::test::stellar_match_fixture::TMatch;
+
+struct StellarMatchTest : public stellar::test::stellar_match_fixture
+{};
+
+TEST_F(StellarMatchTest, construct)
+{
+    seqan::String<stellar::StellarEditRun> editScripts;
+    TMatch match(align, 0u, true, editScripts);
+
+    EXPECT_EQ(match.databaseRecordID, 0u);
+    EXPECT_TRUE(match.valid);
+    EXPECT_EQ(match.begin1, 2u);
+    EXPECT_EQ(match.end1, 9u);
+    EXPECT_EQ(match.begin2, 2u);
+    EXPECT_EQ(match.end2, 9u);
+    EXPECT_EQ(length(match), 8u);
+    EXPECT_EQ(match.matchingColumns, 0u);
+    EXPECT_EQ(stellar::_countMatchingColumns(match, editScripts), 5u);
+    EXPECT_EQ(match.database, &database);
+    EXPECT_EQ(match.query, &query);
+
+    std::vector<std::pair<uint32_t, uint32_t>> runs;
+    for (stellar::StellarEditRun const editRun : stellar::_editScript(match, editScripts))
+        runs.emplace_back(editRun.kind, editRun.count);
+
+    std::vector<std::pair<uint32_t, uint32_t>> const expectedRuns{{stellar::StellarEditRun::aligned, 2u},
+                                                                  {stellar::StellarEditRun::deletion, 1u},
+                                                                  {stellar::StellarEditRun::aligned, 3u},
+                                                                  {stellar::StellarEditRun::insertion, 1u},
+                                                                  {stellar::StellarEditRun::aligned, 1u}};
+    EXPECT_EQ(runs, expectedRuns);
+    EXPECT_EQ(stellar::_viewBeginPosition(match, editScripts, 0), 0u);
+    EXPECT_EQ(stellar::_viewBeginPosition(match, editScripts, 1), 0u);
+}
+
+TEST_F(StellarMatchTest, cigarAndIdentity)
+{
+    seqan::String<stellar::StellarEditRun> editScripts;
+    TMatch const match = countedMatch(align, 0u, true, editScripts);
+
+    std::stringstream cigar, mutations;
+    stellar::_getCigarLine(match, editScripts, cigar, mutations);
+    EXPECT_EQ(cigar.str(), "2M1D3M1I1M");
+    EXPECT_EQ(mutations.str(), "6G,7A");
+
+    EXPECT_EQ(stellar::_computeIdentity(match), 62.5);
+}
+
+TEST_F(StellarMatchTest, matchAlignment)
+{
+    seqan::String<stellar::StellarEditRun> editScripts;
+    TMatch match(align, 0u, true, editScripts);
+
+    TMatch::TAlign matchAlign;
+    stellar::_matchAlignment(match, editScripts, matchAlign);
+
+    for (unsigned rowNo = 0; rowNo < 2u; ++rowNo)
+    {
+        auto const & expectedRow = row(align, rowNo);
+        auto const & actualRow = row(matchAlign, rowNo);
+        ASSERT_EQ(length(actualRow), length(expectedRow)) << "Row: " << rowNo;
+        EXPECT_EQ(beginPosition(actualRow), beginPosition(expectedRow)) << "Row: " << rowNo;
+        EXPECT_EQ(endPosition(actualRow), endPosition(expectedRow)) << "Row: " << rowNo;
+        for (size_t pos = 0; pos < length(expectedRow); ++pos)
+            EXPECT_EQ(isGap(actualRow, pos), isGap(expectedRow, pos)) << "Row: " << rowNo << " Column: " << pos;
+    }
+}
+
+TEST_F(StellarMatchTest, compactEditScripts)
+{
+    seqan::String<stellar::StellarEditRun> editScripts;
+    seqan::String<TMatch> matches;
+    appendValue(matches, TMatch(align, 1u, true, editScripts));
+    appendValue(matches, TMatch(align, 2u, true, editScripts));
+    EXPECT_EQ(length(editScripts), 10u);
+
+    erase(matches, 0u);
+    stellar::_compactEditScripts(matches, editScripts);
+
+    EXPECT_EQ(length(editScripts), 5u);
+    EXPECT_EQ(matches[0].editScriptBegin, 0u);
+    EXPECT_EQ(matches[0].editScriptEnd, 5u);
+    EXPECT_EQ(matches[0].databaseRecordID, 2u);
+}
+
+TEST_F(StellarMatchTest, alignColOverlap)
+{
+    seqan::String<stellar::StellarEditRun> editScripts;
+    TMatch match(align, 0u, true, editScripts);
+
+    // database: CGTACGT
+    // query:    TCGACGG
+    TMatch::TAlign shiftedAlign;
+    resize(rows(shiftedAlign), 2);
+    setSource(row(shiftedAlign, 0), database);
+    setSource(row(shiftedAlign, 1), query);
+    setBeginPosition(row(shiftedAlign, 0), 2u);
+    setEndPosition(row(shiftedAlign, 0), 9u);
+    setBeginPosition(row(shiftedAlign, 1), 1u);
+    setEndPosition(row(shiftedAlign, 1), 8u);
+    TMatch shiftedMatch(shiftedAlign, 0u, true, editScripts);
+
+    // identical matches share all columns
+    EXPECT_TRUE(stellar::_checkAlignColOverlap(match, match, editScripts, 1u));
+
+    // only the database positions 5, 6, 7 are projected onto the same query positions, 4 columns differ
+    EXPECT_FALSE(stellar::_checkAlignColOverlap(match, shiftedMatch, editScripts, 4u));
+    EXPECT_TRUE(stellar::_checkAlignColOverlap(match, shiftedMatch, editScripts, 5u));
+}
+
+TEST_F(StellarMatchTest, maskOverlaps)
+{
+    seqan::String<stellar::StellarEditRun> editScripts;
+    seqan::String<TMatch> matches;
+    appendValue(matches, TMatch(align, 0u, true, editScripts));
+    appendValue(matches, TMatch(align, 1u, true, editScripts));
+    appendValue(matches, TMatch(align, 0u, true, editScripts));
+
+    stellar::maskOverlaps(matches, editScripts, 3u);
+
+    // the duplicate in database 0 is removed, the match in database 1 doesn't overlap
+    ASSERT_EQ(length(matches), 3u);
+    EXPECT_EQ(matches[0].databaseRecordID, 0u);
+    EXPECT_TRUE(matches[0].valid);
+    EXPECT_EQ(matches[1].databaseRecordID, 0u);
+    EXPECT_FALSE(matches[1].valid);
+    EXPECT_EQ(matches[2].databaseRecordID, 1u);
+    EXPECT_TRUE(matches[2].valid);
+}
+
+TEST_F(StellarMatchTest, insertMatch)
+{
+    unsigned const disableThresh = std::numeric_limits<unsigned>::max();
+    unsigned const compactThresh = 0u;
+    unsigned const numMatches = 1u;
+    stellar::QueryMatches<TMatch> queryMatches;
+
+    stellar::_insertMatch(queryMatches, align, 0u, true, 3u, disableThresh, compactThresh, numMatches);
+    ASSERT_EQ(length(queryMatches.matches), 1u);
+    EXPECT_EQ(length(queryMatches.editScripts), 5u);
+    EXPECT_EQ(queryMatches.matches[0].matchingColumns, 5u);
+
+    // a duplicate is rejected
+    stellar::_insertMatch(queryMatches, align, 0u, true, 3u, disableThresh, compactThresh, numMatches);
+    ASSERT_EQ(length(queryMatches.matches), 1u);
+    EXPECT_EQ(length(queryMatches.editScripts), 5u);
+
+    // only numMatches matches are kept, the removed match stays until more matches are removed than kept
+    stellar::_insertMatch(queryMatches, align, 1u, true, 3u, disableThresh, compactThresh, numMatches);
+    ASSERT_EQ(length(queryMatches.matches), 2u);
+    EXPECT_FALSE(queryMatches.matches[0].valid);
+    EXPECT_TRUE(queryMatches.matches[1].valid);
+    EXPECT_EQ(queryMatches.matchesByLength.size(), 1u);
+
+    stellar::_insertMatch(queryMatches, align, 2u, true, 3u, disableThresh, compactThresh, numMatches);
+    ASSERT_EQ(length(queryMatches.matches), 1u);
+    EXPECT_EQ(length(queryMatches.editScripts), 5u);
+    EXPECT_TRUE(queryMatches.matches[0].valid);
+    EXPECT_EQ(queryMatches.matches[0].databaseRecordID, 2u);
+
+    // the stored matches count for the disable threshold, rejected matches don't
+    stellar::QueryMatches<TMatch> disabledQueryMatches;
+    stellar::_insertMatch(disabledQueryMatches, align, 0u, true, 3u, 1u, compactThresh, numMatches);
+    stellar::_insertMatch(disabledQueryMatches, align, 0u, true, 3u, 1u, compactThresh, numMatches);
+    EXPECT_FALSE(disabledQueryMatches.disabled);
+    stellar::_insertMatch(disabledQueryMatches, align, 1u, true, 3u, 1u, compactThresh, numMatches);
+    EXPECT_TRUE(disabledQueryMatches.disabled);
+    EXPECT_TRUE(empty(disabledQueryMatches.matches));
+}
+
+// The matches of one component lie on one diagonal and are contained in the longest match of the component, matches
+// of different components don't overlap. Then the kept matches don't depend on the order of the overlap checks, and
+// inserting the matches one by one has to keep the same matches as masking and compacting all of them at once.
+TEST_F(StellarMatchTest, insertMatchMatchesMaskOverlaps)
+{
+    std::mt19937 rng{13u};
+    unsigned const disableThresh = std::numeric_limits<unsigned>::max();
+    unsigned const compactThresh = std::numeric_limits<unsigned>::max();
+    unsigned const minLength = 3u;
+
+    TSequence sequence{};
+    for (size_t i = 0; i < 400u; ++i)
+        appendValue(sequence, TAlphabet{rng() % 4});
+
+    auto makeAlign = [&](size_t const databaseBegin, size_t const diagonal, size_t const matchLength)
+    {
+        TMatch::TAlign matchAlign{};
+        resize(rows(matchAlign), 2);
+        setSource(row(matchAlign, 0), sequence);
+        setSource(row(matchAlign, 1), sequence);
+        setBeginPosition(row(matchAlign, 0), databaseBegin);
+        setEndPosition(row(matchAlign, 0), databaseBegin + matchLength);
+        setBeginPosition(row(matchAlign, 1), databaseBegin + diagonal);
+        setEndPosition(row(matchAlign, 1), databaseBegin + diagonal + matchLength);
+        return matchAlign;
+    };
+
+    auto validMatches = [](seqan::String<TMatch> const & matches)
+    {
+        std::vector<std::tuple<size_t, size_t, size_t>> positions{};
+        for (TMatch const & match : matches)
+            if (match.valid)
+                positions.emplace_back(match.begin1, match.end1, match.begin2);
+        std::sort(positions.begin(), positions.end());
+        return positions;
+    };
+
+    for (size_t iteration = 0; iteration < 500u; ++iteration)
+    {
+        // distinct lengths, such that the numMatches longest matches are unique
+        std::vector<size_t> matchLengths(195u);
+        std::iota(matchLengths.begin(), matchLengths.end(), 5u);
+        std::shuffle(matchLengths.begin(), matchLengths.end(), rng);
+
+        std::vector<TMatch::TAlign> aligns{};
+        size_t const componentCount = 1u + rng() % 12u;
+        for (size_t component = 0; component < componentCount; ++component)
+        {
+            size_t const matchCount = 1u + rng() % 4u;
+            std::vector<size_t> componentLengths(matchLengths.end() - matchCount, matchLengths.end());
+            matchLengths.resize(matchLengths.size() - matchCount);
+            std::sort(componentLengths.begin(), componentLengths.end());
+
+            size_t const longestLength = componentLengths.back();
+            size_t const longestBegin = rng() % 100u;
+            for (size_t const matchLength : componentLengths)
+            {
+                size_t const matchBegin = longestBegin + rng() % (longestLength - matchLength + 1u);
+                aligns.push_back(makeAlign(matchBegin, component, matchLength));
+            }
+        }
+        std::shuffle(aligns.begin(), aligns.end(), rng);
+
+        unsigned const numMatches = 1u + rng() % 6u;
+
+        seqan::String<stellar::StellarEditRun> editScripts;
+        seqan::String<TMatch> matches;
+        for (TMatch::TAlign const & matchAlign : aligns)
+            appendValue(matches, TMatch(matchAlign, 0u, true, editScripts));
+        stellar::maskOverlaps(matches, editScripts, minLength);
+        stellar::compactMatches(matches, numMatches);
+
+        stellar::QueryMatches<TMatch> queryMatches;
+        for (TMatch::TAlign const & matchAlign : aligns)
+            stellar::_insertMatch(queryMatches, matchAlign, 0u, true, minLength, disableThresh, compactThresh, numMatches);
+        queryMatches.removeOverlapsAndCompactMatches(disableThresh, 0u, minLength, numMatches);
+
+        EXPECT_EQ(validMatches(queryMatches.matches), validMatches(matches)) << "Iteration: " << iteration;
+    }
+}
+
+TEST_F(StellarMatchTest, gffFormatter)
+{
+    seqan::String<stellar::StellarEditRun> editScripts;
+    seqan::StringSet<seqan::CharString> databaseIDs;
+    appendValue(databaseIDs, "db0 first");
+    appendValue(databaseIDs, "db1\tsecond");
+    seqan::CharString const queryID{"query some description"};
+
+    std::vector<std::string_view> const shortDatabaseIDs = stellar::_shortIdViews(databaseIDs);
+    EXPECT_EQ(shortDatabaseIDs, (std::vector<std::string_view>{"db0", "db1"}));
+    stellar::StellarGffFormatter formatter{shortDatabaseIDs};
+
+    std::string buffer;
+    std::stringstream expected;
+    for (TMatch const & match : {countedMatch(align, 0u, true, editScripts), countedMatch(align, 1u, false, editScripts)}) {
+        formatter.appendMatch(buffer, stellar::_shortIdView(queryID), 3u, match, editScripts);
+        stellar::_writeMatchGff(databaseIDs[match.databaseRecordID], queryID, match.orientation, 3u, match,
+                                editScripts, expected);
+    }
+
+    EXPECT_EQ(buffer, expected.str());
+    EXPECT_EQ(buffer.substr(0, buffer.find('\n')),
+              "db0\tStellar\teps-matches\t3\t9\t62.5\t+\t.\tquery;seq2Range=3,9;eValue=0"
+              ";cigar=2M1D3M1I1M;mutations=6G,7A");
+}
+
+TEST_F(StellarMatchTest, lengthAdjustment)
+{
+    TSequence const longQuery{"TTCGACGGATTCGACGGATTCGACGGA"};
+    TMatch::TAlign longAlign;
+    resize(rows(longAlign), 2);
+    setSource(row(longAlign, 0), database);
+    setSource(row(longAlign, 1), longQuery);
+    setBeginPosition(row(longAlign, 0), 2u);
+    setEndPosition(row(longAlign, 0), 9u);
+    setBeginPosition(row(longAlign, 1), 2u);
+    setEndPosition(row(longAlign, 1), 9u);
+    insertGaps(row(longAlign, 1), 2u, 1u);
+    insertGaps(row(longAlign, 0), 6u, 1u);
+
+    // queries 0 and 2 have the same length, query 1 has no matches
+    seqan::StringSet<stellar::QueryMatches<TMatch>> matches;
+    resize(matches, 4);
+    appendValue(matches[0].matches, TMatch(align, 0u, true, matches[0].editScripts));
+    appendValue(matches[2].matches, TMatch(align, 0u, true, matches[2].editScripts));
+    appendValue(matches[3].matches, TMatch(longAlign, 0u, true, matches[3].editScripts));
+
+    uint64_t const refLen = 1000000u;
+    stellar::_postproccessLengthAdjustment(refLen, matches);
+
+    EXPECT_EQ(matches[0].lengthAdjustment, stellar::_computeLengthAdjustment<uint64_t>(refLen, length(query)));
+    EXPECT_EQ(matches[1].lengthAdjustment, 0u);
+    EXPECT_EQ(matches[2].lengthAdjustment, matches[0].lengthAdjustment);
+    EXPECT_EQ(matches[3].lengthAdjustment, stellar::_computeLengthAdjustment<uint64_t>(refLen, length(longQuery)));
+}
@@ -13,6 +13,7 @@ TEST(AllLocal, empty)
     seqan::String<TAlphabet> database{};
     seqan::String<TAlphabet> query{};
     stellar::stellar_verification_time verification_runtime{};
+    stellar::StellarVerificationContext<seqan::String<TAlphabet>> verification_context{};
 
     stellar::StellarDatabaseSegment<TAlphabet> databaseSegment{database, 0u, 0u};
     stellar::StellarQuerySegment<TAlphabet> querySegment{query, 0u, 0u};
@@ -38,6 +39,7 @@ TEST(AllLocal, empty)
             return true;
         },
         verification_runtime,
+        verification_context,
         stellar::AllLocal{}
     );
 }
@@ -50,6 +52,7 @@ TEST(AllLocal, validSeedWithExactMatches)
     // original
     TSequence query{"CTCGAGGGTTTACGCATATCTGG" "TAACCGCAGAACACG" "A" "AGAGCCTGAGA"};
     stellar::stellar_verification_time verification_runtime{};
+    stellar::StellarVerificationContext<seqan::String<TAlphabet>> verification_context{};
 
     stellar::StellarDatabaseSegment<TAlphabet> databaseSegment{database, 20u, 20u + 16u};
     stellar::StellarQuerySegment<TAlphabet> querySegment{query, 14u, 14u + 6u + 3u + 16u + 11u};
@@ -78,6 +81,7 @@ TEST(AllLocal, validSeedWithExactMatches)
             return true;
         },
         verification_runtime,
+        verification_context,
         stellar::AllLocal{}
     );
 
@@ -103,6 +107,7 @@ TEST(AllLocal, oneErrorInsertion)
     // 1 error, insert in query sequence
     TSequence query{"CTCGAGGGTTTACGCATATCTGG" "TAACCGC" "A" "AGAACACG" "A" "AGAGCCTGAGA"};
     stellar::stellar_verification_time verification_runtime{};
+    stellar::StellarVerificationContext<seqan::String<TAlphabet>> verification_context{};
 
     stellar::StellarDatabaseSegment<TAlphabet> databaseSegment{database, 20u, 20u + 16u};
     stellar::StellarQuerySegment<TAlphabet> querySegment{query, 14u, 14u + 9u + 17u + 11u};
@@ -131,6 +136,7 @@ TEST(AllLocal, oneErrorInsertion)
             return true;
         },
         verification_runtime,
+        verification_context,
         stellar::AllLocal{}
     );
 
@@ -169,6 +175,7 @@ TEST(AllLocal, oneErrorDeletion)
     // 1 error, delete in query sequence
     TSequence query{"CTCGAGGGTTTACGCATATCTGG" "TAACCG"/*C*/"AGAACACG" "A" "AGAGCCTGAGA"};
     stellar::stellar_verification_time verification_runtime{};
+    stellar::StellarVerificationContext<seqan::String<TAlphabet>> verification_context{};
 
     stellar::StellarDatabaseSegment<TAlphabet> databaseSegment{database, 27u, 27u + 9u};
     stellar::StellarQuerySegment<TAlphabet> querySegment{query, 21u, 21u + 6u + 2u + 9u + 11u};
@@ -197,6 +204,7 @@ TEST(AllLocal, oneErrorDeletion)
             return true;
         },
         verification_runtime,
+        verification_context,
         stellar::AllLocal{}
     );
 
@@ -222,6 +230,7 @@ TEST(AllLocal, oneErrorSubstitution)
     // 1 error, substitution in query sequence
     TSequence query{"CTCGAGGGTTTACGCATATCTGG" "TAACCG" "G" "AGAACACG" "A" "AGAGCCTGAGA"};
     stellar::stellar_verification_time verification_runtime{};
+    stellar::StellarVerificationContext<seqan::String<TAlphabet>> verification_context{};
 
     stellar::StellarDatabaseSegment<TAlphabet> databaseSegment{database, 27u, 27u + 9u};
     stellar::StellarQuerySegment<TAlphabet> querySegment{query, 21u, 21u + 6u + 3u + 9u + 11u};
@@ -250,6 +259,7 @@ TEST(AllLocal, oneErrorSubstitution)
             return true;
         },
         verification_runtime,
+        verification_context,
         stellar::AllLocal{}
     );
 
@@ -266,3 +276,61 @@ TEST(AllLocal, oneErrorSubstitution)
     EXPECT_EQ(errors.error_columns, 2u);
     EXPECT_DOUBLE_EQ(errors.error_rate(), 2.0 / 17.0);
 }
+
+TEST(AllLocal, reusedVerificationContext)
+{
+    using TAlphabet = seqan::Dna5;
+    using TSequence = seqan::String<TAlphabet>;
+    TSequence database{"CAACGGACTGCTGTCTAGAC" "TAACCGC"/* */"AGAACACG" "A" "CTCCTCTACCTTACCGCGT"};
+    TSequence query{"CTCGAGGGTTTACGCATATCTGG" "TAACCGC" "A" "AGAACACG" "A" "AGAGCCTGAGA"};
+    stellar::stellar_verification_time verification_runtime{};
+    stellar::StellarVerificationContext<seqan::String<TAlphabet>> verification_context{};
+
+    stellar::StellarDatabaseSegment<TAlphabet> databaseSegment{database, 20u, 20u + 16u};
+    stellar::StellarQuerySegment<TAlphabet> querySegment{query, 14u, 14u + 9u + 17u + 11u};
+    // a longer swift hit leaves larger buffers in the context
+    stellar::StellarDatabaseSegment<TAlphabet> longDatabaseSegment{database, 0u, length(database)};
+    stellar::StellarQuerySegment<TAlphabet> longQuerySegment{query, 0u, length(query)};
+
+    double epsilon = 0.125;
+    int minLength = 9;
+    unsigned delta = 16u;
+    double xDrop = 5.0; // default from app
+
+    using TAlignment = seqan::Align<TSequence const, seqan::ArrayGaps>;
+
+    auto verify = [&](auto const & hitDatabaseSegment, auto const & hitQuerySegment, auto & context)
+    {
+        std::vector<TAlignment> hitAlignments;
+        stellar::verifySwiftHit(
+            hitDatabaseSegment.asFinderSegment(), //infH
+            hitQuerySegment.asPatternSegment(), //infV
+            epsilon,
+            minLength,
+            xDrop,
+            delta,
+            [&](auto & alignment) -> bool
+            {
+                hitAlignments.push_back(alignment);
+                return true;
+            },
+            verification_runtime,
+            context,
+            stellar::AllLocal{}
+        );
+        return hitAlignments;
+    };
+
+    stellar::StellarVerificationContext<seqan::String<TAlphabet>> fresh_context{};
+    std::vector<TAlignment> expected = verify(databaseSegment, querySegment, fresh_context);
+    ASSERT_EQ(expected.size(), 1u);
+
+    verify(longDatabaseSegment, longQuerySegment, verification_context);
+    std::vector<TAlignment> alignments = verify(databaseSegment, querySegment, verification_context);
+
+    ASSERT_EQ(alignments.size(), 1u);
+    EXPECT_EQ(row(alignments[0], 0), row(expected[0], 0));
+    EXPECT_EQ(row(alignments[0], 1), row(expected[0], 1));
+    EXPECT_EQ(beginPosition(row(alignments[0], 0)), beginPosition(row(expected[0], 0)));
+    EXPECT_EQ(beginPosition(row(alignments[0], 1)), beginPosition(row(expected[0], 1)));
+}
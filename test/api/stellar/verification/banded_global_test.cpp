@@ -0,0 +1,141 @@
+#include <gtest/gtest.h>
+
+#include <stellar/test/error_rate.hpp>
+
+#include <stellar/stellar_extension.hpp>
+#include <stellar/verification/banded_global.hpp>
+
+#include <stellar/stellar_database_segment.hpp>
+#include <stellar/stellar_query_segment.hpp>
+
+TEST(BandedGlobal, empty)
+{
+    using TAlphabet = seqan::Dna5;
+    seqan::String<TAlphabet> database{};
+    seqan::String<TAlphabet> query{};
+    stellar::stellar_verification_time verification_runtime{};
+    stellar::StellarVerificationContext<seqan::String<TAlphabet>> verification_context{};
+
+    stellar::StellarDatabaseSegment<TAlphabet> databaseSegment{database, 0u, 0u};
+    stellar::StellarQuerySegment<TAlphabet> querySegment{query, 0u, 0u};
+
+    double epsilon = 0.01;
+    int minLength = 9;
+    unsigned delta = 16u;
+    double xDrop = 5.0; // default from app
+
+    stellar::verifySwiftHit(
+        databaseSegment.asFinderSegment(), //infH
+        querySegment.asPatternSegment(), //infV
+        epsilon,
+        minLength,
+        xDrop,
+        delta,
+        [](auto && alignment) -> bool
+        {
+            std::cout << "alignment: " << alignment << std::endl;
+            ADD_FAILURE() << "Empty sequences should not have any alignment." << std::endl;
+            return true;
+        },
+        verification_runtime,
+        verification_context,
+        stellar::BandedGlobal{}
+    );
+}
+
+TEST(BandedGlobal, exactMatch)
+{
+    using TAlphabet = seqan::Dna5;
+    using TSequence = seqan::String<TAlphabet>;
+    TSequence database{"CAACGG" "TAACCGCAGAACACGA" "CTCC"};
+    TSequence query{"GGG" "TAACCGCAGAACACGA" "TT"};
+    stellar::stellar_verification_time verification_runtime{};
+    stellar::StellarVerificationContext<seqan::String<TAlphabet>> verification_context{};
+
+    stellar::StellarDatabaseSegment<TAlphabet> databaseSegment{database, 6u, 6u + 16u};
+    stellar::StellarQuerySegment<TAlphabet> querySegment{query, 3u, 3u + 16u};
+
+    double epsilon = 0.125;
+    int minLength = 9;
+    unsigned delta = 16u;
+    double xDrop = 5.0; // default from app
+
+    using TAlignment = seqan::Align<TSequence const, seqan::ArrayGaps>;
+    std::vector<TAlignment> alignments;
+
+    stellar::verifySwiftHit(
+        databaseSegment.asFinderSegment(), //infH
+        querySegment.asPatternSegment(), //infV
+        epsilon,
+        minLength,
+        xDrop,
+        delta,
+        [&](auto & alignment) -> bool
+        {
+            static_assert(std::is_same<decltype(alignment), TAlignment &>::value, "");
+            alignments.push_back(alignment);
+            return true;
+        },
+        verification_runtime,
+        verification_context,
+        stellar::BandedGlobal{}
+    );
+
+    ASSERT_EQ(alignments.size(), 1u);
+    EXPECT_EQ(row(alignments[0], 0), "TAACCGCAGAACACGA");
+    EXPECT_EQ(row(alignments[0], 1), "TAACCGCAGAACACGA");
+    EXPECT_EQ(beginPosition(row(alignments[0], 0)), 6u);
+    EXPECT_EQ(beginPosition(row(alignments[0], 1)), 3u);
+
+    stellar::test::error_rate_t errors = stellar::test::error_rate(alignments[0]);
+    EXPECT_EQ(errors.alignment_length, 16u);
+    EXPECT_EQ(errors.error_columns, 0u);
+}
+
+TEST(BandedGlobal, oneErrorSubstitution)
+{
+    using TAlphabet = seqan::Dna5;
+    using TSequence = seqan::String<TAlphabet>;
+    TSequence database{"CAACGG" "TAACCGC" "A" "GAACACGA" "CTCC"};
+    // 1 error, substitution in query sequence
+    TSequence query{"GGG" "TAACCGC" "T" "GAACACGA" "TT"};
+    stellar::stellar_verification_time verification_runtime{};
+    stellar::StellarVerificationContext<seqan::String<TAlphabet>> verification_context{};
+
+    stellar::StellarDatabaseSegment<TAlphabet> databaseSegment{database, 6u, 6u + 16u};
+    stellar::StellarQuerySegment<TAlphabet> querySegment{query, 3u, 3u + 16u};
+
+    double epsilon = 0.125;
+    int minLength = 9;
+    unsigned delta = 16u;
+    double xDrop = 5.0; // default from app
+
+    using TAlignment = seqan::Align<TSequence const, seqan::ArrayGaps>;
+    std::vector<TAlignment> alignments;
+
+    stellar::verifySwiftHit(
+        databaseSegment.asFinderSegment(), //infH
+        querySegment.asPatternSegment(), //infV
+        epsilon,
+        minLength,
+        xDrop,
+        delta,
+        [&](auto & alignment) -> bool
+        {
+            alignments.push_back(alignment);
+            return true;
+        },
+        verification_runtime,
+        verification_context,
+        stellar::BandedGlobal{}
+    );
+
+    ASSERT_EQ(alignments.size(), 1u);
+    EXPECT_EQ(row(alignments[0], 0), "TAACCGCAGAACACGA");
+    //                                ||||||| ||||||||
+    EXPECT_EQ(row(alignments[0], 1), "TAACCGCTGAACACGA");
+
+    stellar::test::error_rate_t errors = stellar::test::error_rate(alignments[0]);
+    EXPECT_EQ(errors.alignment_length, 16u);
+    EXPECT_EQ(errors.error_columns, 1u);
+}
@@ -0,0 +1,76 @@
+#include <gtest/gtest.h>
+
+#include <random>
+
+#include <stellar/verification/detail/banded_local_max_score.hpp>
+
+using TAlphabet = seqan::Dna5;
+using TSequence = seqan::String<TAlphabet>;
+using TSwiftHit = stellar::StellarSwiftHit<TAlphabet>;
+
+TSequence randomSequence(std::mt19937 & rng, size_t const sequenceLength)
+{
+    TSequence sequence{};
+    for (size_t i = 0; i < sequenceLength; ++i)
+        appendValue(sequence, TAlphabet{rng() % 4});
+    return sequence;
+}
+
+// the score of the best banded local alignment as allOrBestLocal computes it
+int expectedMaxScore(TSwiftHit const & swiftHit, double const eps)
+{
+    auto infH = swiftHit.databaseSegment.asFinderSegment();
+    auto infV = swiftHit.querySegment.asPatternSegment();
+
+    int const mismatchIndel = stellar::_allOrBestLocalMismatchIndel<int>(eps, length(host(infH)));
+    seqan::Score<int> scoreMatrix(1, mismatchIndel, mismatchIndel);
+    auto [lowerDiag, upperDiag] = stellar::_allOrBestLocalDiagonals(infH, infV, swiftHit.delta);
+
+    return seqan::localAlignmentScore(infH, infV, scoreMatrix, lowerDiag, upperDiag);
+}
+
+TEST(BandedLocalMaxScores, random_batches)
+{
+    std::mt19937 rng{42u};
+    double const eps = 0.05;
+
+    TSequence database = randomSequence(rng, 2000u);
+    seqan::StringSet<TSequence> queries{};
+    for (size_t i = 0; i < 4u; ++i)
+    {
+        // queries share parts with the database
+        TSequence query = randomSequence(rng, 200u);
+        for (size_t position = 0; position < 100u; ++position)
+            query[50u + position] = database[400u * i + position];
+        for (size_t errors = 0; errors < 4u; ++errors)
+            query[50u + rng() % 100u] = TAlphabet{rng() % 4};
+        appendValue(queries, query);
+    }
+
+    // the buffers are reused, more hits than lanes are aligned in several batches
+    stellar::StellarBandedLocalScoreBuffers buffers{};
+    for (size_t hitCount = 1u; hitCount <= 3u * stellar::_bandedLocalBatchSize; ++hitCount)
+    {
+        std::vector<TSwiftHit> swiftHits{};
+        for (size_t hitID = 0; hitID < hitCount; ++hitID)
+        {
+            TSequence const & query = queries[rng() % length(queries)];
+            size_t const queryBegin = rng() % 60u;
+            size_t const queryEnd = length(query) - rng() % 60u;
+            size_t const databaseBegin = rng() % 1700u;
+            size_t const databaseEnd = databaseBegin + (queryEnd - queryBegin) - rng() % 20u;
+
+            swiftHits.push_back(TSwiftHit{
+                stellar::StellarDatabaseSegment<TAlphabet>{database, databaseBegin, databaseEnd},
+                stellar::StellarQuerySegment<TAlphabet>{query, queryBegin, queryEnd},
+                static_cast<unsigned>(16u + rng() % 16u)
+            });
+        }
+
+        std::vector<int> maxScores(hitCount);
+        stellar::_bandedLocalMaxScores(std::span<TSwiftHit const>{swiftHits}, eps, std::span<int>{maxScores}, buffers);
+
+        for (size_t hitID = 0; hitID < hitCount; ++hitID)
+            EXPECT_EQ(maxScores[hitID], expectedMaxScore(swiftHits[hitID], eps)) << "hits " << hitCount << " hit " << hitID;
+    }
+}
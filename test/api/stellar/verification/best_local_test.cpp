@@ -13,6 +13,7 @@ TEST(BestLocal, empty)
     seqan::String<TAlphabet> database{};
     seqan::String<TAlphabet> query{};
     stellar::stellar_verification_time verification_runtime{};
+    stellar::StellarVerificationContext<seqan::String<TAlphabet>> verification_context{};
 
     stellar::StellarDatabaseSegment<TAlphabet> databaseSegment{database, 0u, 0u};
     stellar::StellarQuerySegment<TAlphabet> querySegment{query, 0u, 0u};
@@ -38,6 +39,7 @@ TEST(BestLocal, empty)
             return true;
         },
         verification_runtime,
+        verification_context,
         stellar::BestLocal{}
     );
 }
@@ -50,6 +52,7 @@ TEST(BestLocal, validSeedWithExactMatches)
     // original
     TSequence query{"CTCGAGGGTTTACGCATATCTGG" "TAACCGCAGAACACG" "A" "AGAGCCTGAGA"};
     stellar::stellar_verification_time verification_runtime{};
+    stellar::StellarVerificationContext<seqan::String<TAlphabet>> verification_context{};
 
     stellar::StellarDatabaseSegment<TAlphabet> databaseSegment{database, 20u, 20u + 16u};
     stellar::StellarQuerySegment<TAlphabet> querySegment{query, 14u, 14u + 6u + 3u + 16u + 11u};
@@ -78,6 +81,7 @@ TEST(BestLocal, validSeedWithExactMatches)
             return true;
         },
         verification_runtime,
+        verification_context,
         stellar::BestLocal{}
     );
 
@@ -103,6 +107,7 @@ TEST(BestLocal, oneErrorInsertion)
     // 1 error, insert in query sequence
     TSequence query{"CTCGAGGGTTTACGCATATCTGG" "TAACCGC" "A" "AGAACACG" "A" "AGAGCCTGAGA"};
     stellar::stellar_verification_time verification_runtime{};
+    stellar::StellarVerificationContext<seqan::String<TAlphabet>> verification_context{};
 
     stellar::StellarDatabaseSegment<TAlphabet> databaseSegment{database, 20u, 20u + 16u};
     stellar::StellarQuerySegment<TAlphabet> querySegment{query, 14u, 14u + 9u + 17u + 11u};
@@ -131,6 +136,7 @@ TEST(BestLocal, oneErrorInsertion)
             return true;
         },
         verification_runtime,
+        verification_context,
         stellar::BestLocal{}
     );
 
@@ -156,6 +162,7 @@ TEST(BestLocal, oneErrorDeletion)
     // 1 error, delete in query sequence
     TSequence query{"CTCGAGGGTTTACGCATATCTGG" "TAACCG"/*C*/"AGAACACG" "A" "AGAGCCTGAGA"};
     stellar::stellar_verification_time verification_runtime{};
+    stellar::StellarVerificationContext<seqan::String<TAlphabet>> verification_context{};
 
     stellar::StellarDatabaseSegment<TAlphabet> databaseSegment{database, 27u, 27u + 9u};
     stellar::StellarQuerySegment<TAlphabet> querySegment{query, 21u, 21u + 6u + 2u + 9u + 11u};
@@ -184,6 +191,7 @@ TEST(BestLocal, oneErrorDeletion)
             return true;
         },
         verification_runtime,
+        verification_context,
         stellar::BestLocal{}
     );
 
@@ -209,6 +217,7 @@ TEST(BestLocal, oneErrorSubstitution)
     // 1 error, substitution in query sequence
     TSequence query{"CTCGAGGGTTTACGCATATCTGG" "TAACCG" "G" "AGAACACG" "A" "AGAGCCTGAGA"};
     stellar::stellar_verification_time verification_runtime{};
+    stellar::StellarVerificationContext<seqan::String<TAlphabet>> verification_context{};
 
     stellar::StellarDatabaseSegment<TAlphabet> databaseSegment{database, 27u, 27u + 9u};
     stellar::StellarQuerySegment<TAlphabet> querySegment{query, 21u, 21u + 6u + 3u + 9u + 11u};
@@ -237,6 +246,7 @@ TEST(BestLocal, oneErrorSubstitution)
             return true;
         },
         verification_runtime,
+        verification_context,
         stellar::BestLocal{}
     );
 
@@ -0,0 +1,89 @@
+#include <gtest/gtest.h>
+
+#include <random>
+
+#include <stellar/verification/swift_hit_precheck.hpp>
+
+#include <stellar/stellar_database_segment.hpp>
+#include <stellar/stellar_query_segment.hpp>
+
+using TAlphabet = seqan::Dna5;
+using TSequence = seqan::String<TAlphabet>;
+
+TSequence randomSequence(std::mt19937 & rng, size_t const sequenceLength)
+{
+    TSequence sequence{};
+    for (size_t i = 0; i < sequenceLength; ++i)
+        appendValue(sequence, TAlphabet{rng() % 4});
+    return sequence;
+}
+
+// minimal edit distance of pattern to any substring of text by dynamic programming
+unsigned minimalEditDistance(TSequence const & pattern, TSequence const & text)
+{
+    std::vector<unsigned> previous(length(text) + 1, 0u);
+    std::vector<unsigned> current(length(text) + 1);
+    for (size_t i = 1; i <= length(pattern); ++i)
+    {
+        current[0] = i;
+        for (size_t j = 1; j <= length(text); ++j)
+            current[j] = std::min({previous[j - 1] + (pattern[i - 1] != text[j - 1]), previous[j] + 1, current[j - 1] + 1});
+        std::swap(previous, current);
+    }
+    return *std::min_element(previous.begin(), previous.end());
+}
+
+TEST(SwiftHitPrecheck, myersMinimalEditDistance)
+{
+    std::mt19937 rng{42u};
+    std::vector<uint64_t> patternMasks{};
+
+    for (size_t iteration = 0; iteration < 1000u; ++iteration)
+    {
+        TSequence pattern = randomSequence(rng, 1u + rng() % 64u);
+        TSequence text = randomSequence(rng, rng() % 150u);
+
+        EXPECT_EQ(stellar::_myersMinimalEditDistance(pattern, text, patternMasks), minimalEditDistance(pattern, text));
+    }
+}
+
+TEST(SwiftHitPrecheck, epsMatch)
+{
+    std::mt19937 rng{42u};
+    TSequence database = randomSequence(rng, 150u);
+    TSequence query = infix(database, 10u, 140u);
+
+    // 5 substitutions in 130 positions
+    for (size_t position : {15u, 40u, 63u, 90u, 121u})
+        query[position] = TAlphabet{(ordValue(query[position]) + 1) % 4};
+
+    stellar::StellarDatabaseSegment<TAlphabet> databaseSegment{database, 0u, length(database)};
+    stellar::StellarQuerySegment<TAlphabet> querySegment{query, 0u, length(query)};
+
+    EXPECT_TRUE(stellar::_swiftHitMayContainEpsMatch(databaseSegment, querySegment, 0.05, 100u, 16u));
+}
+
+TEST(SwiftHitPrecheck, random)
+{
+    std::mt19937 rng{42u};
+    TSequence database = randomSequence(rng, 150u);
+    TSequence query = randomSequence(rng, 130u);
+
+    stellar::StellarDatabaseSegment<TAlphabet> databaseSegment{database, 0u, length(database)};
+    stellar::StellarQuerySegment<TAlphabet> querySegment{query, 0u, length(query)};
+
+    EXPECT_FALSE(stellar::_swiftHitMayContainEpsMatch(databaseSegment, querySegment, 0.05, 100u, 16u));
+}
+
+TEST(SwiftHitPrecheck, short_min_length)
+{
+    std::mt19937 rng{42u};
+    TSequence database = randomSequence(rng, 20u);
+    TSequence query = randomSequence(rng, 20u);
+
+    stellar::StellarDatabaseSegment<TAlphabet> databaseSegment{database, 0u, length(database)};
+    stellar::StellarQuerySegment<TAlphabet> querySegment{query, 0u, length(query)};
+
+    // blocks would be shorter than 4
+    EXPECT_TRUE(stellar::_swiftHitMayContainEpsMatch(databaseSegment, querySegment, 0.05, 12u, 16u));
+}
@@ -0,0 +1,117 @@
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <stellar/stellar_binary_output.hpp>
+
+using TSequence = seqan::String<seqan::Dna5>;
+using TMatch = stellar::StellarMatch<TSequence const, seqan::CharString>;
+
+// The same matches as in gff_formatter_benchmark: matchCount matches of about 100 columns between a random database
+// and a copy of it with 5% substitutions, each with a few pairs of gaps.
+struct BinaryMatches
+{
+    explicit BinaryMatches(size_t const matchCount)
+    {
+        std::mt19937 rng{42u};
+        std::uniform_int_distribution<int> base{0, 3};
+        std::uniform_real_distribution<double> chance{0.0, 1.0};
+
+        for (size_t i = 0; i < 1000u; ++i)
+        {
+            seqan::Dna5 const c = base(rng);
+            appendValue(database, c);
+            appendValue(query, chance(rng) < 0.05 ? seqan::Dna5(base(rng)) : c);
+        }
+        appendValue(databaseIDs, "chr1 benchmark database");
+        appendValue(queryIDs, "read1 benchmark query");
+
+        for (size_t i = 0; i < matchCount; ++i)
+        {
+            size_t const begin = (i * 37u) % 800u;
+            TMatch::TAlign align{};
+            resize(rows(align), 2);
+            setSource(row(align, 0), database);
+            setSource(row(align, 1), query);
+            setBeginPosition(row(align, 0), begin);
+            setEndPosition(row(align, 0), begin + 100u);
+            setBeginPosition(row(align, 1), begin);
+            setEndPosition(row(align, 1), begin + 100u);
+            for (size_t pos = 80u; pos > 0u; pos -= 20u)
+            {
+                if (chance(rng) < 0.5)
+                {
+                    insertGaps(row(align, 1), pos + 5u, 1u);
+                    insertGaps(row(align, 0), pos, 1u);
+                }
+            }
+            TMatch match(align, 0u, i % 2u == 0u, editScripts);
+            match.matchingColumns = stellar::_countMatchingColumns(match, editScripts);
+            appendValue(matches, match);
+        }
+    }
+
+    // Writes the matches as binary match file with one block.
+    void write(std::ostream & file, stellar::StellarBinaryMatches & block) const
+    {
+        stellar::_writeBinaryMatchesHeader<seqan::Dna5>(databaseIDs, queryIDs, file);
+
+        block.clear();
+        for (TMatch const & match : matches)
+            stellar::_appendBinaryMatch(block, 0u, 0u, match, editScripts);
+        stellar::_writeBinaryMatchesBlock(block, file);
+    }
+
+    TSequence database{};
+    TSequence query{};
+    seqan::StringSet<seqan::CharString> databaseIDs{};
+    seqan::StringSet<seqan::CharString> queryIDs{};
+    seqan::String<stellar::StellarEditRun> editScripts{};
+    seqan::String<TMatch> matches{};
+};
+
+// Writes the matches in the binary match format into a std::ostringstream.
+static void binary_write(benchmark::State & state)
+{
+    BinaryMatches const data(state.range(0));
+    stellar::StellarBinaryMatches block{};
+    size_t fileBytes{};
+
+    for (auto _ : state)
+    {
+        std::ostringstream file;
+        data.write(file, block);
+        fileBytes = static_cast<size_t>(file.tellp());
+        benchmark::DoNotOptimize(fileBytes);
+    }
+
+    state.SetItemsProcessed(state.iterations() * length(data.matches));
+    state.counters["file_bytes"] = fileBytes;
+}
+
+// Converts a binary match file into gff format with _convertBinaryMatchesToGff, like stellar convert.
+static void binary_to_gff(benchmark::State & state)
+{
+    BinaryMatches const data(state.range(0));
+    stellar::StellarBinaryMatches block{};
+    std::ostringstream binaryFile;
+    data.write(binaryFile, block);
+    std::string const binaryContent = binaryFile.str();
+
+    for (auto _ : state)
+    {
+        std::istringstream input{binaryContent};
+        std::ostringstream gffFile;
+        bool const converted = stellar::_convertBinaryMatchesToGff(input, gffFile);
+        benchmark::DoNotOptimize(converted);
+        benchmark::DoNotOptimize(gffFile.tellp());
+    }
+
+    state.SetItemsProcessed(state.iterations() * length(data.matches));
+}
+
+BENCHMARK(binary_write)->Arg(1 << 10)->Arg(1 << 14);
+BENCHMARK(binary_to_gff)->Arg(1 << 10)->Arg(1 << 14);
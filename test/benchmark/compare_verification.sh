@@ -0,0 +1,58 @@
+#!/bin/bash
+
+# Compares the verification strategy bandedGlobal with the default (exact, i.e. all local alignments) on the
+# simulated data sets of test/cli with respect to the number of matches, the found matches of exact, and time.
+#
+# Usage: bash compare_verification.sh [<stellar binary>]
+
+set -e
+
+STELLAR=${1:-../../build/bin/stellar}
+DATA=../cli
+OUT=$(mktemp -d)
+trap "rm -rf $OUT" EXIT
+
+# Prints the number of matches in $1 that overlap a match in $2 on the same strand in database and query.
+count_found()
+{
+  awk -F '\t' '
+    function range(attributes,   r) { match(attributes, /seq2Range=[0-9]+,[0-9]+/); r = substr(attributes, RSTART + 10, RLENGTH - 10); return r }
+    NR == FNR { split(range($9), q, ","); db[NR] = $1; dbBegin[NR] = $4; dbEnd[NR] = $5; strand[NR] = $7; qBegin[NR] = q[1]; qEnd[NR] = q[2]; n = NR; next }
+    {
+      split(range($9), q, ",")
+      for (i = 1; i <= n; ++i)
+        if (db[i] == $1 && strand[i] == $7 && dbBegin[i] <= $5 && $4 <= dbEnd[i] && qBegin[i] <= q[2] && q[1] <= qEnd[i])
+        {
+          ++found
+          break
+        }
+    }
+    END { print found + 0 }' "$2" "$1"
+}
+
+# Runs stellar with verification strategy $1 and prints the wall time in seconds.
+run_stellar()
+{
+  local start=$(date +%s.%N)
+  ${STELLAR} -e $2 -l 50 -x 10 -k 7 -n 5000 -s 10000 -vs $1 -o $OUT/$1.gff \
+             $DATA/512_simSeq1_$3.fa $DATA/512_simSeq2_$3.fa --suppress-runtime-printing > /dev/null
+  local end=$(date +%s.%N)
+  echo "$end - $start" | bc
+}
+
+printf "%-8s %14s %14s %14s %14s %14s\n" "eps" "exact matches" "exact time" "banded matches" "found exact" "banded time"
+
+for eps in "e-1:0.1" "75e-3:0.075" "5e-2:0.05" "25e-3:0.025" "e-4:0.0001"
+do
+  name=${eps%%:*}
+  errRate=${eps##*:}
+
+  exact_time=$(run_stellar exact $errRate $name)
+  banded_time=$(run_stellar bandedGlobal $errRate $name)
+
+  exact_matches=$(wc -l < $OUT/exact.gff)
+  banded_matches=$(wc -l < $OUT/bandedGlobal.gff)
+  found=$(count_found $OUT/exact.gff $OUT/bandedGlobal.gff)
+
+  printf "%-8s %14s %14s %14s %14s %14s\n" $name $exact_matches $exact_time $banded_matches $found $banded_time
+done
@@ -0,0 +1,89 @@
+#include <random>
+
+#include <benchmark/benchmark.h>
+
+#include <stellar/stellar_extension.hpp>
+
+using TSequence = seqan::String<seqan::Dna5>;
+using TEndInfo = stellar::ExtensionEndPosition<size_t>;
+
+// A random sequence and a copy with errorRate errors, like the sequences of an extension of an eps-core.
+seqan::StringSet<TSequence> similarSequences(size_t const length, double const errorRate)
+{
+    std::mt19937 rng{42u};
+    std::uniform_int_distribution<int> base{0, 3};
+    std::uniform_real_distribution<double> chance{0.0, 1.0};
+
+    TSequence database{};
+    TSequence query{};
+    for (size_t i = 0; i < length; ++i)
+    {
+        seqan::Dna5 const c = base(rng);
+        appendValue(database, c);
+
+        double const r = chance(rng);
+        if (r < errorRate / 3) // substitution
+        {
+            appendValue(query, seqan::Dna5(base(rng)));
+        }
+        else if (r < 2 * errorRate / 3) // insertion
+        {
+            appendValue(query, c);
+            appendValue(query, seqan::Dna5(base(rng)));
+        }
+        else if (r >= errorRate) // match, otherwise deletion
+        {
+            appendValue(query, c);
+        }
+    }
+
+    seqan::StringSet<TSequence> sequences{};
+    appendValue(sequences, database);
+    appendValue(sequences, query);
+    return sequences;
+}
+
+size_t traceByteSize(seqan::String<seqan::TraceBack> const & trace)
+{
+    return length(trace) * sizeof(seqan::TraceBack);
+}
+
+size_t traceByteSize(stellar::extension_packed_trace const & trace)
+{
+    return trace.byteSize();
+}
+
+// Fills the trace matrix of an extension of length state.range(0) with band width state.range(1) and traces back
+// from the longest end.
+template <typename TTrace>
+static void banded_extension_trace(benchmark::State & state)
+{
+    seqan::StringSet<TSequence> const sequences = similarSequences(state.range(0), 0.05);
+    int const bandRadius = state.range(1) / 2;
+    seqan::Score<int> const scoreMatrix(1, -19, -19);
+
+    TTrace trace{};
+    seqan::String<TEndInfo> possibleEnds{};
+    stellar::AlignBandedNwBestEndsBuffers<int> buffers{};
+    seqan::AlignTraceback<size_t> traceBack{};
+
+    for (auto _ : state)
+    {
+        stellar::_align_banded_nw_best_ends(trace, possibleEnds, sequences, scoreMatrix, -bandRadius, bandRadius,
+                                            buffers);
+
+        clear(traceBack.sizes);
+        clear(traceBack.tvs);
+        stellar::_alignBandedNeedlemanWunschTrace(traceBack, sequences, trace, back(possibleEnds).coord,
+                                                  -bandRadius, bandRadius);
+        benchmark::DoNotOptimize(length(traceBack.tvs));
+    }
+
+    state.counters["trace_bytes"] = traceByteSize(trace);
+    state.SetItemsProcessed(state.iterations() * (length(sequences[1]) + 1) * (2 * bandRadius + 1));
+}
+
+BENCHMARK_TEMPLATE(banded_extension_trace, seqan::String<seqan::TraceBack>)
+    ->ArgsProduct({{1 << 10, 1 << 13}, {16, 128, 1024}});
+BENCHMARK_TEMPLATE(banded_extension_trace, stellar::extension_packed_trace)
+    ->ArgsProduct({{1 << 10, 1 << 13}, {16, 128, 1024}});
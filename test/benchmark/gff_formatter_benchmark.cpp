@@ -0,0 +1,103 @@
+#include <random>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <stellar/stellar_output.hpp>
+
+using TSequence = seqan::String<seqan::Dna5>;
+using TMatch = stellar::StellarMatch<TSequence const, seqan::CharString>;
+
+// matchCount matches of about 100 columns between a random database and a copy of it with 5% substitutions, each
+// with a few pairs of gaps.
+struct GffMatches
+{
+    explicit GffMatches(size_t const matchCount)
+    {
+        std::mt19937 rng{42u};
+        std::uniform_int_distribution<int> base{0, 3};
+        std::uniform_real_distribution<double> chance{0.0, 1.0};
+
+        for (size_t i = 0; i < 1000u; ++i)
+        {
+            seqan::Dna5 const c = base(rng);
+            appendValue(database, c);
+            appendValue(query, chance(rng) < 0.05 ? seqan::Dna5(base(rng)) : c);
+        }
+        appendValue(databaseIDs, "chr1 benchmark database");
+
+        for (size_t i = 0; i < matchCount; ++i)
+        {
+            size_t const begin = (i * 37u) % 800u;
+            TMatch::TAlign align{};
+            resize(rows(align), 2);
+            setSource(row(align, 0), database);
+            setSource(row(align, 1), query);
+            setBeginPosition(row(align, 0), begin);
+            setEndPosition(row(align, 0), begin + 100u);
+            setBeginPosition(row(align, 1), begin);
+            setEndPosition(row(align, 1), begin + 100u);
+            for (size_t pos = 80u; pos > 0u; pos -= 20u)
+            {
+                if (chance(rng) < 0.5)
+                {
+                    insertGaps(row(align, 1), pos + 5u, 1u);
+                    insertGaps(row(align, 0), pos, 1u);
+                }
+            }
+            TMatch match(align, 0u, i % 2u == 0u, editScripts);
+            match.matchingColumns = stellar::_countMatchingColumns(match, editScripts);
+            appendValue(matches, match);
+        }
+    }
+
+    TSequence database{};
+    TSequence query{};
+    seqan::StringSet<seqan::CharString> databaseIDs{};
+    seqan::CharString queryID{"read1 benchmark query"};
+    seqan::String<stellar::StellarEditRun> editScripts{};
+    seqan::String<TMatch> matches{};
+};
+
+// Formats the matches with _writeMatchGff into a std::ostringstream.
+static void gff_ostream(benchmark::State & state)
+{
+    GffMatches const data(state.range(0));
+
+    for (auto _ : state)
+    {
+        std::ostringstream buffer;
+        for (TMatch const & match : data.matches)
+            stellar::_writeMatchGff(data.databaseIDs[0], data.queryID, match.orientation, 0u, match,
+                                    data.editScripts, buffer);
+        benchmark::DoNotOptimize(buffer.tellp());
+    }
+
+    state.SetItemsProcessed(state.iterations() * length(data.matches));
+}
+
+// Formats the matches with stellar::StellarGffFormatter into a reused std::string.
+static void gff_formatter(benchmark::State & state)
+{
+    GffMatches const data(state.range(0));
+    std::vector<std::string_view> const shortDatabaseIDs = stellar::_shortIdViews(data.databaseIDs);
+    stellar::StellarGffFormatter formatter{shortDatabaseIDs};
+    std::string_view const shortQueryID = stellar::_shortIdView(data.queryID);
+    std::string buffer;
+
+    for (auto _ : state)
+    {
+        buffer.clear();
+        for (TMatch const & match : data.matches)
+            formatter.appendMatch(buffer, shortQueryID, 0u, match, data.editScripts);
+        benchmark::DoNotOptimize(buffer.data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * length(data.matches));
+}
+
+BENCHMARK(gff_ostream)->Arg(1 << 10)->Arg(1 << 14);
+BENCHMARK(gff_formatter)->Arg(1 << 10)->Arg(1 << 14);
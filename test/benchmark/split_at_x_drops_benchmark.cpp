@@ -0,0 +1,74 @@
+#include <random>
+
+#include <benchmark/benchmark.h>
+
+#include <stellar/verification/detail/all_or_best_local.hpp>
+
+using TSequence = seqan::String<seqan::Dna5>;
+using TAlign = seqan::Align<TSequence>;
+
+// An alignment of a random sequence with a copy that has errorRate errors, with long regions of high error rate in
+// between (divergent data), such that _splitAtXDrops finds several sub-alignments.
+TAlign divergentAlignment(size_t const length, double const errorRate)
+{
+    std::mt19937 rng{42u};
+    std::uniform_int_distribution<int> base{0, 3};
+    std::uniform_real_distribution<double> chance{0.0, 1.0};
+
+    TSequence database{};
+    TSequence query{};
+    for (size_t i = 0; i < length; ++i)
+    {
+        seqan::Dna5 const c = base(rng);
+        appendValue(database, c);
+
+        // every 500 positions 50 positions with 50% errors
+        double const localErrorRate = (i % 500 < 50) ? 0.5 : errorRate;
+        double const r = chance(rng);
+        if (r < localErrorRate / 3) // substitution
+        {
+            appendValue(query, seqan::Dna5(base(rng)));
+        }
+        else if (r < 2 * localErrorRate / 3) // insertion
+        {
+            appendValue(query, c);
+            appendValue(query, seqan::Dna5(base(rng)));
+        }
+        else if (r >= localErrorRate) // match, otherwise deletion
+        {
+            appendValue(query, c);
+        }
+    }
+
+    TAlign align;
+    resize(rows(align), 2);
+    assignSource(row(align, 0), database);
+    assignSource(row(align, 1), query);
+    seqan::globalAlignment(align, seqan::Score<int>(1, -19, -19), seqan::AlignConfig<true, true, true, true>());
+    return align;
+}
+
+static void split_at_x_drops(benchmark::State & state)
+{
+    double const eps = 0.05;
+    TAlign const align = divergentAlignment(state.range(0), eps / 2);
+
+    int const mismatchIndel = stellar::_allOrBestLocalMismatchIndel<int>(eps, length(source(row(align, 0))));
+    seqan::Score<int> const scoreMatrix(1, mismatchIndel, mismatchIndel);
+    int const scoreDropOff = 5 * (-mismatchIndel);
+    int const minScore = stellar::_allOrBestLocalMinScore(eps, 100);
+
+    using TPos = typename seqan::Position<seqan::Row<TAlign>::Type>::Type;
+    stellar::SplitAtXDropsScratch<TPos, int> scratch{};
+
+    for (auto _ : state)
+    {
+        stellar::_splitAtXDrops(align, scoreMatrix, scoreDropOff, minScore, scratch);
+        benchmark::DoNotOptimize(length(scratch.clipRanges));
+    }
+
+    state.counters["sub_alignments"] = length(scratch.clipRanges);
+    state.SetBytesProcessed(state.iterations() * length(row(align, 0)));
+}
+
+BENCHMARK(split_at_x_drops)->RangeMultiplier(4)->Range(1 << 10, 1 << 16);
@@ -117,3 +117,7 @@ struct stellar_base : public cli_test
 };
 
 struct stellar_search : public stellar_base, public testing::WithParamInterface<std::tuple<size_t, std::pair<size_t, size_t>>> {};
+
+struct stellar_verification : public stellar_base {};
+
+struct stellar_stream_output : public stellar_base {};
@@ -1,10 +1,36 @@
+#include <algorithm>
 #include <fstream>
+#include <random>
 #include <ranges>     // range comparisons
+#include <sstream>
 #include <string>                // strings
 #include <vector>                // vectors
 
 #include "cli_test.hpp"
 
+#if SEQAN_HAS_ZLIB
+#include <zlib.h>
+
+// reads a gzip file, including files of several gzip members like BGZF files
+std::string string_from_gzip_file(std::string const & path)
+{
+    gzFile file = gzopen(path.c_str(), "rb");
+    if (file == nullptr)
+        throw std::logic_error{"Cannot open " + path};
+
+    std::string content{};
+    char buffer[4096];
+    int bytesRead{};
+    while ((bytesRead = gzread(file, buffer, sizeof(buffer))) > 0)
+        content.append(buffer, bytesRead);
+    gzclose(file);
+
+    if (bytesRead < 0)
+        throw std::logic_error{"Cannot decompress " + path};
+    return content;
+}
+#endif // SEQAN_HAS_ZLIB
+
 TEST_P(stellar_search, prefiltered)
 {
     auto const [seq, seg_range] = GetParam();
@@ -41,6 +67,47 @@ TEST_P(stellar_search, prefiltered)
     EXPECT_EQ(expected_output, actual_output);
 }
 
+TEST_P(stellar_search, compressed_output)
+{
+#if SEQAN_HAS_ZLIB
+    auto const [seq, seg_range] = GetParam();
+
+    for (std::string const outputFile : {"out.gff", "out.gff.gz"})
+    {
+        cli_test_result const result = execute_app("stellar",
+                                                    data("ref.fasta"),
+                                                    data("query_e0.05.fasta"),
+                                                    "-o", outputFile,
+                                                    "--sequenceOfInterest ", std::to_string(seq),
+                                                    "--segmentBegin ", std::to_string(seg_range.first),
+                                                    "--segmentEnd ", std::to_string(seg_range.second),
+                                                    "--epsilon 0.05",
+                                                    "--minLength 50",
+                                                    "-k 15",
+                                                    "--threads 4",
+                                                    "--suppress-runtime-printing",
+                                                    "> out.stdout");
+        EXPECT_EQ(result.exit_code, 0);
+    }
+
+    std::string const expected_matches = string_from_file(out_path(seq, seg_range.first, seg_range.second, "gff"), std::ios::binary);
+    std::string const plain_matches = string_from_file("out.gff", std::ios::binary);
+    std::string const compressed_file = string_from_file("out.gff.gz", std::ios::binary);
+    std::string const decompressed_matches = string_from_gzip_file("out.gff.gz");
+
+    EXPECT_EQ(plain_matches, expected_matches);
+    EXPECT_EQ(decompressed_matches, plain_matches);
+
+    // a complete BGZF file ends with an empty BGZF block
+    std::string const bgzf_eof_block{"\x1f\x8b\x08\x04\x00\x00\x00\x00\x00\xff\x06\x00\x42\x43\x02\x00"
+                                     "\x1b\x00\x03\x00\x00\x00\x00\x00\x00\x00\x00\x00", 28};
+    ASSERT_GE(compressed_file.size(), bgzf_eof_block.size());
+    EXPECT_EQ(compressed_file.substr(compressed_file.size() - bgzf_eof_block.size()), bgzf_eof_block);
+#else
+    GTEST_SKIP() << "Writing a compressed output file requires zlib.";
+#endif // SEQAN_HAS_ZLIB
+}
+
 INSTANTIATE_TEST_SUITE_P(stellar_suite,
                          stellar_search,
                          testing::Combine(testing::Values(0), testing::Values(std::make_pair(0, 400), std::make_pair(500, 643), std::make_pair(600, 763))),
@@ -51,3 +118,196 @@ INSTANTIATE_TEST_SUITE_P(stellar_suite,
                                                 std::to_string(std::get<1>(info.param).second);
                              return name;
                          });
+
+struct gff_match
+{
+    std::string database_id{};
+    size_t database_begin{};
+    size_t database_end{};
+    char strand{};
+    std::string query_id{};
+    size_t query_begin{};
+    size_t query_end{};
+
+    bool overlaps(gff_match const & other) const
+    {
+        return database_id == other.database_id && strand == other.strand &&
+               database_begin <= other.database_end && other.database_begin <= database_end &&
+               query_begin <= other.query_end && other.query_begin <= query_end;
+    }
+};
+
+std::vector<gff_match> matches_from_gff(std::string const & gff)
+{
+    std::vector<gff_match> matches{};
+    std::istringstream lines{gff};
+    std::string line{};
+    while (std::getline(lines, line))
+    {
+        std::vector<std::string> fields{};
+        std::istringstream field_stream{line};
+        for (std::string field{}; std::getline(field_stream, field, '\t');)
+            fields.push_back(field);
+        if (fields.size() < 9u)
+            continue;
+
+        // the attributes start with "<query id>;seq2Range=<begin>,<end>;"
+        size_t const range_begin = fields[8].find("seq2Range=") + 10u;
+        size_t const range_separator = fields[8].find(',', range_begin);
+
+        matches.push_back(gff_match{fields[0],
+                                    std::stoul(fields[3]),
+                                    std::stoul(fields[4]),
+                                    fields[6][0],
+                                    fields[8].substr(0u, fields[8].find(';')),
+                                    std::stoul(fields[8].substr(range_begin, range_separator - range_begin)),
+                                    std::stoul(fields[8].substr(range_separator + 1u))});
+    }
+    return matches;
+}
+
+// Compares the matches of the verification strategy bandedGlobal with the matches of exact (the gold standard of the
+// cli tests) on simulated sequences with 500 planted matches of length 50 to 200 and error rate 0.05.
+TEST_F(stellar_verification, banded_global_matches_exact)
+{
+    cli_test_result const result = execute_app("stellar",
+                                                "--alphabet dna5",
+                                                "--forward",
+                                                "--epsilon 0.05",
+                                                "--minLength 50",
+                                                "--xDrop 10",
+                                                "--kmer 7",
+                                                "--numMatches 5000",
+                                                "--sortThresh 10000",
+                                                "--verification bandedGlobal",
+                                                "--suppress-runtime-printing",
+                                                "--out banded_global.gff",
+                                                data("512_simSeq1_5e-2.fa"),
+                                                data("512_simSeq2_5e-2.fa"),
+                                                "> out.stdout");
+    EXPECT_EQ(result.exit_code, 0);
+
+    std::vector<gff_match> const exact_matches = matches_from_gff(string_from_file(data("dna5_forward_5e-2.gff")));
+    std::vector<gff_match> const banded_matches = matches_from_gff(string_from_file("banded_global.gff"));
+    ASSERT_FALSE(exact_matches.empty());
+    ASSERT_FALSE(banded_matches.empty());
+
+    // each match of bandedGlobal is an eps-match of at least minLength, apart from the planted matches the random
+    // sequences have none, so it overlaps a match of exact
+    for (gff_match const & banded_match : banded_matches)
+    {
+        EXPECT_GE(banded_match.database_end - banded_match.database_begin + 1u, 50u);
+        EXPECT_TRUE(std::ranges::any_of(exact_matches, [&](gff_match const & exact_match)
+        {
+            return exact_match.overlaps(banded_match);
+        })) << "bandedGlobal match " << banded_match.database_begin << "-" << banded_match.database_end
+            << " doesn't overlap a match of exact";
+    }
+
+    size_t const found_exact_matches = std::ranges::count_if(exact_matches, [&](gff_match const & exact_match)
+    {
+        return std::ranges::any_of(banded_matches, [&](gff_match const & banded_match)
+        {
+            return exact_match.overlaps(banded_match);
+        });
+    });
+    RecordProperty("exact_matches", exact_matches.size());
+    RecordProperty("banded_global_matches", banded_matches.size());
+    RecordProperty("found_exact_matches", found_exact_matches);
+
+    // bandedGlobal aligns one swift hit at once and finds at most one match per swift hit, but each planted match
+    // is covered by a swift hit
+    EXPECT_GE(2u * found_exact_matches, exact_matches.size());
+}
+
+std::string random_dna(std::mt19937 & rng, size_t const length)
+{
+    std::string sequence{};
+    for (size_t i = 0; i < length; ++i)
+        sequence += "ACGT"[rng() % 4];
+    return sequence;
+}
+
+std::string reverse_complement(std::string const & sequence)
+{
+    std::string complement{};
+    for (auto it = sequence.rbegin(); it != sequence.rend(); ++it)
+        complement += (*it == 'A') ? 'T' : (*it == 'C') ? 'G' : (*it == 'G') ? 'C' : 'A';
+    return complement;
+}
+
+// --streamOutput on a database of two records:
+//   query "often" occurs 6 times in each record on both strands and is disabled (disableThresh 4) on each strand
+//   query "many" occurs 3 times and query "once" once in each record on the forward strand
+TEST_F(stellar_stream_output, per_record)
+{
+    std::mt19937 rng{7u};
+    std::string const often = random_dna(rng, 150u);
+    std::string const many = random_dna(rng, 150u);
+    std::string const once = random_dna(rng, 150u);
+
+    std::ofstream database_file{"database.fasta"};
+    for (std::string const database_id : {"db1", "db2"})
+    {
+        std::string record = random_dna(rng, 200u);
+        for (size_t i = 0; i < 6u; ++i)
+            record += often + random_dna(rng, 200u) + reverse_complement(often) + random_dna(rng, 200u);
+        for (size_t i = 0; i < 3u; ++i)
+            record += many + random_dna(rng, 200u);
+        record += once + random_dna(rng, 200u);
+        database_file << '>' << database_id << '\n' << record << '\n';
+    }
+    database_file.close();
+
+    std::ofstream query_file{"queries.fasta"};
+    query_file << ">often\n" << often << "\n>many\n" << many << "\n>once\n" << once << '\n';
+    query_file.close();
+
+    cli_test_result const result = execute_app("stellar",
+                                                "database.fasta",
+                                                "queries.fasta",
+                                                "--epsilon 0.05",
+                                                "--minLength 100",
+                                                "--numMatches 2",
+                                                "--disableThresh 4",
+                                                "--streamOutput",
+                                                "--verbose",
+                                                "--suppress-runtime-printing",
+                                                "--out out.gff",
+                                                "--outDisabled disabled.fasta",
+                                                "> out.stdout");
+    EXPECT_EQ(result.exit_code, 0);
+
+    std::vector<gff_match> const matches = matches_from_gff(string_from_file("out.gff"));
+
+    // the matches are grouped by strand and database record: db1 before db2
+    std::vector<std::string> database_ids{};
+    for (gff_match const & match : matches)
+        database_ids.push_back(match.database_id);
+    EXPECT_TRUE(std::ranges::is_sorted(database_ids));
+    EXPECT_TRUE(std::ranges::all_of(matches, [](gff_match const & match) { return match.strand == '+'; }));
+
+    // numMatches applies per query and database record, the disabled query has no matches
+    auto count_matches = [&](std::string const & query_id, std::string const & database_id)
+    {
+        return std::ranges::count_if(matches, [&](gff_match const & match)
+        {
+            return match.query_id == query_id && match.database_id == database_id;
+        });
+    };
+    EXPECT_EQ(count_matches("many", "db1"), 2);
+    EXPECT_EQ(count_matches("many", "db2"), 2);
+    EXPECT_EQ(count_matches("once", "db1"), 1);
+    EXPECT_EQ(count_matches("once", "db2"), 1);
+    EXPECT_EQ(count_matches("often", "db1") + count_matches("often", "db2"), 0);
+    EXPECT_EQ(matches.size(), 6u);
+
+    // the disabled query is listed once per strand
+    std::string const disabled_queries = string_from_file("disabled.fasta");
+    EXPECT_EQ(disabled_queries, ">often\n" + often + "\n\n>often\n" + often + "\n\n");
+
+    // the output statistics add up over the database records
+    std::string const output = string_from_file("out.stdout");
+    EXPECT_NE(output.find("# Eps-matches     : 6\n"), std::string::npos) << output;
+    EXPECT_NE(output.find("# Disabled queries: 2\n"), std::string::npos) << output;
+}
@@ -95,3 +95,12 @@ declare_datasource (FILE 0_600_763.stdout
 declare_datasource (FILE full.stdout
                 URL ${CMAKE_SOURCE_DIR}/test/data/full.stdout
                 URL_HASH SHA256=6fce12cb3bab0baa51fa7180f5c946ee24b28b05f435472d64386dd80cf42a3b)
+declare_datasource (FILE 512_simSeq1_5e-2.fa
+                URL ${CMAKE_SOURCE_DIR}/test/cli/512_simSeq1_5e-2.fa
+                URL_HASH SHA256=ce7c85ca5484bab69c5d65baafc48eaf2615f2e1f9c83eeeb0ada56d6f1116e4)
+declare_datasource (FILE 512_simSeq2_5e-2.fa
+                URL ${CMAKE_SOURCE_DIR}/test/cli/512_simSeq2_5e-2.fa
+                URL_HASH SHA256=564d7282ff7ce20da3110e157b4e70b59d09e11d454d993747f8685bec88f7da)
+declare_datasource (FILE dna5_forward_5e-2.gff
+                URL ${CMAKE_SOURCE_DIR}/test/cli/gold_standard/dna5_forward/5e-2.gff
+                URL_HASH SHA256=1f026f37a6ae14d46c89363c7a9f7c7b58bcc2f21c6162325da7d5ae55ecb47d)
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include <stellar/stellar_types.hpp>
+
+namespace stellar::test
+{
+
+// A StellarMatch alignment with a deletion and an insertion, shared by the tests of matches and of their output:
+// database: CGTACG-T
+// query:    CG-ACGGA
+struct stellar_match_fixture : public ::testing::Test
+{
+    using TAlphabet = seqan::Dna5;
+    using TSequence = seqan::String<TAlphabet>;
+    using TMatch = stellar::StellarMatch<TSequence const, seqan::CharString>;
+
+    void SetUp() override
+    {
+        resize(rows(align), 2);
+        setSource(row(align, 0), database);
+        setSource(row(align, 1), query);
+        setBeginPosition(row(align, 0), 2u);
+        setEndPosition(row(align, 0), 9u);
+        setBeginPosition(row(align, 1), 2u);
+        setEndPosition(row(align, 1), 9u);
+        insertGaps(row(align, 1), 2u, 1u);
+        insertGaps(row(align, 0), 6u, 1u);
+    }
+
+    // a match of the alignment with counted matching columns, like the matches stored by _insertMatch
+    static TMatch countedMatch(TMatch::TAlign const & matchAlign,
+                               uint32_t const databaseRecordID,
+                               bool const orientation,
+                               seqan::String<stellar::StellarEditRun> & editScripts)
+    {
+        TMatch match(matchAlign, databaseRecordID, orientation, editScripts);
+        match.matchingColumns = stellar::_countMatchingColumns(match, editScripts);
+        return match;
+    }
+
+    TSequence const database{"AACGTACGTT"};
+    TSequence const query{"TTCGACGGA"};
+    TMatch::TAlign align{};
+};
+
+} // namespace stellar::test